@@ -18,6 +18,7 @@
 #include "inet/networklayer/common/L3AddressResolver.h"
 #include "inet/transportlayer/contract/udp/UdpControlInfo_m.h"
 #include "inet/routing/ospfv2/router/Ospfv2Common.h"
+#include "inet/routing/ospfv2/router/Ospfv2ResultFiles.h"
 
 namespace inet {
 
@@ -28,8 +29,6 @@ UdpBasicApp::~UdpBasicApp()
     cancelAndDelete(selfMsg);
 }
 
-std::ofstream UdpBasicApp::ofs;
-
 void UdpBasicApp::initialize(int stage)
 {
     ClockUserModuleMixin::initialize(stage);
@@ -52,20 +51,6 @@ void UdpBasicApp::initialize(int stage)
          */
         eedSignal = registerSignal("eed");
 
-        if (!ofs.is_open()) {
-            std::string filename = "/home/sqsq/Desktop/"
-                    "sat-ospf/inet/examples/ospfv2/sqsqtest/results/";
-            filename += EXPERIMENT_NAME;
-            filename += "/";
-
-            filename += IS_OSPF ? "OSPF" : std::to_string(SQSQ_HOP);
-
-            filename += "/";
-            filename += getEnvir()->getConfigEx()->getActiveConfigName();
-            filename += "/successPacketRaw.csv";
-            ofs.open(filename, std::ios::app);
-        }
-
         if (stopTime >= CLOCKTIME_ZERO && stopTime < startTime)
             throw cRuntimeError("Invalid startTime/stopTime parameters");
         selfMsg = new ClockEvent("sendTimer");
@@ -76,15 +61,6 @@ void UdpBasicApp::finish()
 {
     recordScalar("packets sent", numSent);
     recordScalar("packets received", numReceived);
-
-    /*
-     * @sqsq
-     */
-
-    if (ofs.is_open()) {
-        ofs.close();
-    }
-
     ApplicationBase::finish();
 }
 
@@ -231,7 +207,8 @@ void UdpBasicApp::handleMessageWhenUp(cMessage *msg)
 //        std::cout << "at " << simTime() << ", " << getFullName() << " eed: " << eed << std::endl;
         emit(eedSignal, eed);
 
-        if (ofs.is_open() && RECORD_CSV) {
+        if (RECORD_CSV) {
+            std::ostream& ofs = ospfv2::Ospfv2ResultFiles::getFile("successPacketRaw.csv");
             ofs << getEnvir()->getConfigEx()->getActiveConfigName() << ",";
             ofs << SQSQ_HOP << ",";
             ofs << this->getParentModule()->getFullPath() << ",";
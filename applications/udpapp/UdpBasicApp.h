@@ -49,7 +49,6 @@ class INET_API UdpBasicApp : public ClockUserModuleMixin<ApplicationBase>, publi
      * @sqsq
      */
     simsignal_t eedSignal;
-    static std::ofstream ofs;
 
   protected:
     virtual int numInitStages() const override { return NUM_INIT_STAGES; }
@@ -0,0 +1,260 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+
+#include "inet/common/CalendarEventSet.h"
+
+#include <algorithm>
+
+namespace inet {
+
+Register_Class(CalendarEventSet);
+
+CalendarEventSet::CalendarEventSet(const char *name) : cFutureEventSet(name)
+{
+    createBuckets(MIN_NUM_BUCKETS);
+}
+
+CalendarEventSet::~CalendarEventSet()
+{
+    clear();
+    deleteBuckets();
+}
+
+bool CalendarEventSet::precedes(const cEvent *a, const cEvent *b)
+{
+    // the insertion order is only known within a bucket, but the events of equal arrival time are in the same bucket
+    simtime_t ta = a->getArrivalTime();
+    simtime_t tb = b->getArrivalTime();
+    if (ta != tb)
+        return ta < tb;
+    return a->getSchedulingPriority() < b->getSchedulingPriority();
+}
+
+void CalendarEventSet::setPosition(int64_t t) const
+{
+    currentBucket = getBucketIndex(t);
+    bucketTop = (t / bucketWidth + 1) * bucketWidth;
+}
+
+void CalendarEventSet::createBuckets(int numBuckets)
+{
+    for (int i = 0; i < numBuckets; i++) {
+        cEventHeap *bucket = new cEventHeap(nullptr, BUCKET_CAPACITY);
+        take(bucket);
+        buckets.push_back(bucket);
+    }
+}
+
+void CalendarEventSet::deleteBuckets()
+{
+    for (auto bucket : buckets)
+        dropAndDelete(bucket);
+    buckets.clear();
+}
+
+void CalendarEventSet::insertIntoBucket(cEvent *event)
+{
+    int64_t t = event->getArrivalTime().raw();
+    // the calendar must never be positioned after an event
+    if (t < bucketTop - bucketWidth)
+        setPosition(t);
+    int index = getBucketIndex(t);
+    buckets[index]->insert(event);
+    if (firstBucket != -1 && firstBucket != index && precedes(event, buckets[firstBucket]->peekFirst()))
+        firstBucket = index;
+    eventsValid = false;
+}
+
+int CalendarEventSet::findFirst() const
+{
+    if (length == 0)
+        return -1;
+    // look for an event within the current year, starting at the current bucket
+    int numBuckets = buckets.size();
+    int64_t top = bucketTop;
+    for (int i = 0; i < numBuckets; i++) {
+        int index = (currentBucket + i) & (numBuckets - 1);
+        cEvent *first = buckets[index]->peekFirst();
+        if (first != nullptr && first->getArrivalTime().raw() < top) {
+            currentBucket = index;
+            bucketTop = top;
+            return index;
+        }
+        top += bucketWidth;
+    }
+    // all events are at least a year ahead, search directly
+    int index = -1;
+    for (int i = 0; i < numBuckets; i++) {
+        cEvent *first = buckets[i]->peekFirst();
+        if (first != nullptr && (index == -1 || precedes(first, buckets[index]->peekFirst())))
+            index = i;
+    }
+    setPosition(buckets[index]->peekFirst()->getArrivalTime().raw());
+    return index;
+}
+
+int64_t CalendarEventSet::estimateBucketWidth(std::vector<cEvent *>& sortedEvents) const
+{
+    // average distance of the earliest events, leaving out the large gaps (Brown)
+    int sampleSize = std::min((int)sortedEvents.size(), 25);
+    if (sampleSize < 2)
+        return bucketWidth;
+    double totalGap = (sortedEvents[sampleSize - 1]->getArrivalTime() - sortedEvents[0]->getArrivalTime()).raw();
+    double averageGap = totalGap / (sampleSize - 1);
+    double sum = 0;
+    int count = 0;
+    for (int i = 1; i < sampleSize; i++) {
+        double gap = (sortedEvents[i]->getArrivalTime() - sortedEvents[i - 1]->getArrivalTime()).raw();
+        if (gap <= 2 * averageGap) {
+            sum += gap;
+            count++;
+        }
+    }
+    if (count == 0 || sum == 0)
+        return bucketWidth;
+    return std::max((int64_t)1, (int64_t)(3 * sum / count));
+}
+
+void CalendarEventSet::resize(int numBuckets)
+{
+    // the events leave every bucket in order, and a stable sort keeps that order for the events
+    // of equal arrival time and priority, so inserting them again preserves their insertion order
+    std::vector<cEvent *> sortedEvents;
+    sortedEvents.reserve(length);
+    for (auto bucket : buckets) {
+        while (cEvent *event = bucket->removeFirst())
+            sortedEvents.push_back(event);
+    }
+    std::stable_sort(sortedEvents.begin(), sortedEvents.end(), precedes);
+    bucketWidth = estimateBucketWidth(sortedEvents);
+    deleteBuckets();
+    createBuckets(numBuckets);
+    firstBucket = -1;
+    eventsValid = false;
+    if (!sortedEvents.empty())
+        setPosition(sortedEvents.front()->getArrivalTime().raw());
+    else
+        setPosition(bucketTop - 1);
+    for (auto event : sortedEvents)
+        buckets[getBucketIndex(event->getArrivalTime().raw())]->insert(event);
+}
+
+void CalendarEventSet::insert(cEvent *event)
+{
+    insertIntoBucket(event);
+    length++;
+    if (length > 2 * (int)buckets.size())
+        resize(2 * buckets.size());
+}
+
+cEvent *CalendarEventSet::peekFirst() const
+{
+    if (firstBucket == -1)
+        firstBucket = findFirst();
+    return firstBucket == -1 ? nullptr : buckets[firstBucket]->peekFirst();
+}
+
+cEvent *CalendarEventSet::removeFirst()
+{
+    if (peekFirst() == nullptr)
+        return nullptr;
+    cEvent *event = buckets[firstBucket]->removeFirst();
+    firstBucket = -1;
+    eventsValid = false;
+    length--;
+    if (length < (int)buckets.size() / 2 && (int)buckets.size() > MIN_NUM_BUCKETS)
+        resize(buckets.size() / 2);
+    return event;
+}
+
+void CalendarEventSet::putBackFirst(cEvent *event)
+{
+    // the bucket heap keeps the event at its front, so it is the first again
+    int64_t t = event->getArrivalTime().raw();
+    if (t < bucketTop - bucketWidth)
+        setPosition(t);
+    int index = getBucketIndex(t);
+    buckets[index]->putBackFirst(event);
+    firstBucket = index;
+    eventsValid = false;
+    length++;
+}
+
+cEvent *CalendarEventSet::remove(cEvent *event)
+{
+    int index = getBucketIndex(event->getArrivalTime().raw());
+    if (buckets[index]->remove(event) == nullptr)
+        return nullptr;
+    if (firstBucket == index)
+        firstBucket = -1;
+    eventsValid = false;
+    length--;
+    if (length < (int)buckets.size() / 2 && (int)buckets.size() > MIN_NUM_BUCKETS)
+        resize(buckets.size() / 2);
+    return event;
+}
+
+void CalendarEventSet::clear()
+{
+    for (auto bucket : buckets)
+        bucket->clear();
+    if ((int)buckets.size() != MIN_NUM_BUCKETS) {
+        deleteBuckets();
+        createBuckets(MIN_NUM_BUCKETS);
+    }
+    length = 0;
+    firstBucket = -1;
+    events.clear();
+    eventsValid = false;
+}
+
+void CalendarEventSet::collectEvents() const
+{
+    if (!eventsValid) {
+        events.clear();
+        for (auto bucket : buckets)
+            for (int i = 0; i < bucket->getLength(); i++)
+                events.push_back(bucket->get(i));
+        eventsValid = true;
+    }
+}
+
+cEvent *CalendarEventSet::get(int k)
+{
+    if (k < 0 || k >= length)
+        return nullptr;
+    collectEvents();
+    return events[k];
+}
+
+void CalendarEventSet::sort()
+{
+    // a sorted bucket lists its events in order, see resize()
+    events.clear();
+    for (auto bucket : buckets) {
+        bucket->sort();
+        for (int i = 0; i < bucket->getLength(); i++)
+            events.push_back(bucket->get(i));
+    }
+    std::stable_sort(events.begin(), events.end(), precedes);
+    eventsValid = true;
+}
+
+void CalendarEventSet::forEachChild(cVisitor *v)
+{
+    collectEvents();
+    for (auto event : events)
+        v->visit(event);
+}
+
+std::string CalendarEventSet::str() const
+{
+    std::stringstream out;
+    out << "length=" << length << ", buckets=" << buckets.size() << ", bucketWidth=" << SimTime::fromRaw(bucketWidth);
+    return out.str();
+}
+
+} // namespace inet
+
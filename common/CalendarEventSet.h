@@ -0,0 +1,90 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+
+#ifndef __INET_CALENDAREVENTSET_H
+#define __INET_CALENDAREVENTSET_H
+
+#include "inet/common/INETDefs.h"
+
+namespace inet {
+
+/**
+ * Calendar queue implementation of the future event set (R. Brown, 1988).
+ * The time axis is divided into buckets of equal width, which are reused
+ * cyclically like the days of a calendar year; every bucket keeps its events
+ * in a heap. Inserting and removing the first event take O(1) amortized time if
+ * the bucket width matches the typical distance of the events, which is the
+ * case for the periodic protocol timers (hello, ELB, database age, traffic
+ * generation) that dominate the satellite simulations. The number of buckets
+ * follows the number of events, and the width is estimated from the earliest
+ * events whenever the calendar is resized.
+ *
+ * Every bucket is a small cEventHeap, so the events are ordered exactly as
+ * in a single cEventHeap: by arrival time, then by scheduling priority, then
+ * in insertion order (the events of equal arrival time are always in the
+ * same bucket), and the simulation results and fingerprints do not change.
+ * The bucket heaps also maintain the scheduled state of the events, which
+ * only cEventHeap may set.
+ *
+ * Select it in omnetpp.ini with futureeventset-class = "inet::CalendarEventSet",
+ * the default binary heap is "omnetpp::cEventHeap". The tests/fes directory
+ * contains a configuration comparing the two.
+ */
+class INET_API CalendarEventSet : public cFutureEventSet
+{
+  protected:
+    static const int MIN_NUM_BUCKETS = 16;
+    static const int BUCKET_CAPACITY = 4; // initial capacity of the bucket heaps
+
+    std::vector<cEventHeap *> buckets; // the size is a power of two
+    int64_t bucketWidth = 1; // in simtime_t raw units
+    int length = 0;
+
+    // position of the calendar, the current bucket covers [bucketTop - bucketWidth, bucketTop)
+    mutable int currentBucket = 0;
+    mutable int64_t bucketTop = 1;
+    mutable int firstBucket = -1; // cached bucket of the first event, -1 if unknown or empty
+
+    mutable std::vector<cEvent *> events; // for get(k), only valid if eventsValid
+    mutable bool eventsValid = false;
+
+  protected:
+    static bool precedes(const cEvent *a, const cEvent *b);
+
+    int getBucketIndex(int64_t t) const { return (int)((uint64_t)(t / bucketWidth) & (buckets.size() - 1)); }
+    void setPosition(int64_t t) const;
+    void createBuckets(int numBuckets);
+    void deleteBuckets();
+    void insertIntoBucket(cEvent *event);
+    int findFirst() const;
+    void resize(int numBuckets);
+    int64_t estimateBucketWidth(std::vector<cEvent *>& sortedEvents) const;
+    void collectEvents() const;
+
+  public:
+    explicit CalendarEventSet(const char *name = nullptr);
+    CalendarEventSet(const CalendarEventSet& other) = delete;
+    virtual ~CalendarEventSet();
+
+    virtual CalendarEventSet *dup() const override { throw cRuntimeError("CalendarEventSet cannot be duplicated"); }
+    virtual void forEachChild(cVisitor *v) override;
+    virtual std::string str() const override;
+
+    virtual void insert(cEvent *event) override;
+    virtual cEvent *peekFirst() const override;
+    virtual cEvent *removeFirst() override;
+    virtual void putBackFirst(cEvent *event) override;
+    virtual cEvent *remove(cEvent *event) override;
+    virtual bool isEmpty() const override { return length == 0; }
+    virtual void clear() override;
+    virtual int getLength() const override { return length; }
+    virtual cEvent *get(int k) override;
+    virtual void sort() override;
+};
+
+} // namespace inet
+
+#endif
+
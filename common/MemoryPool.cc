@@ -0,0 +1,50 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+
+#include "inet/common/MemoryPool.h"
+
+#include <thread>
+
+#include "inet/common/SimulationScopedSingleton.h"
+
+namespace inet {
+
+namespace {
+
+class MemoryPoolReleaser : public SimulationScopedSingleton<MemoryPoolReleaser>
+{
+  protected:
+    virtual void clear() override { MemoryPool::clear(); }
+};
+
+const std::thread::id mainThreadId = std::this_thread::get_id();
+
+} // namespace
+
+thread_local MemoryPool::FreeLists MemoryPool::freeLists;
+
+void *MemoryPool::allocateFromHeap(size_t sizeClass)
+{
+    // the lifecycle listener is added on the slow path; not during static initialization,
+    // and not from the worker threads, whose free lists live as long as the threads
+    if (std::this_thread::get_id() == mainThreadId && cSimulation::getActiveSimulation() != nullptr)
+        MemoryPoolReleaser::getInstance();
+    return ::operator new((sizeClass + 1) * GRANULARITY);
+}
+
+void MemoryPool::clear()
+{
+    for (size_t i = 0; i < NUM_SIZE_CLASSES; i++) {
+        while (freeLists.heads[i] != nullptr) {
+            FreeBlock *block = freeLists.heads[i];
+            freeLists.heads[i] = block->next;
+            ::operator delete(block);
+        }
+        freeLists.lengths[i] = 0;
+    }
+}
+
+} // namespace inet
+
@@ -0,0 +1,117 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+
+#ifndef __INET_MEMORYPOOL_H
+#define __INET_MEMORYPOOL_H
+
+#include "inet/common/INETDefs.h"
+
+// The following macro allows the user to disable the pooled allocation of
+// packets, chunks and tags, e.g. to run the simulation under a memory checker.
+#ifndef INET_POOLED_ALLOCATION
+#define INET_POOLED_ALLOCATION    1
+#endif
+
+namespace inet {
+
+/**
+ * Size class based free list allocator for the small, frequently allocated
+ * objects of the packet API: packets, chunks, tags and packet events. Freed
+ * blocks are kept in a free list per size class and handed out again for the
+ * next object of the same size class, so forwarding a packet over many hops
+ * does not go to the global heap for every header and tag.
+ *
+ * The free lists are thread local, so the objects may be used in worker
+ * threads as well. Each free list keeps at most MAX_FREE_BLOCKS blocks, the
+ * rest is returned to the heap. Objects larger than MAX_POOLED_SIZE are
+ * allocated from the heap directly. The free lists of the main thread are
+ * returned to the heap before a network is set up and after it is deleted.
+ *
+ * The pool is compiled with INET_POOLED_ALLOCATION=0 as well, only the
+ * classes do not use it then.
+ */
+class INET_API MemoryPool
+{
+  public:
+    static constexpr size_t GRANULARITY = 16;
+    static constexpr size_t MAX_POOLED_SIZE = 1024;
+    static constexpr size_t MAX_FREE_BLOCKS = 4096;
+    static constexpr size_t NUM_SIZE_CLASSES = MAX_POOLED_SIZE / GRANULARITY;
+
+  private:
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    // plain data, so it can be used during static destruction as well
+    struct FreeLists {
+        FreeBlock *heads[NUM_SIZE_CLASSES];
+        size_t lengths[NUM_SIZE_CLASSES];
+    };
+
+    static thread_local FreeLists freeLists;
+
+  private:
+    static size_t getSizeClass(size_t size) { return (size - 1) / GRANULARITY; }
+    static void *allocateFromHeap(size_t sizeClass);
+
+  public:
+    static void *allocate(size_t size) {
+        if (size == 0 || size > MAX_POOLED_SIZE)
+            return ::operator new(size);
+        size_t sizeClass = getSizeClass(size);
+        FreeBlock *block = freeLists.heads[sizeClass];
+        if (block == nullptr)
+            return allocateFromHeap(sizeClass);
+        freeLists.heads[sizeClass] = block->next;
+        freeLists.lengths[sizeClass]--;
+        return block;
+    }
+
+    static void deallocate(void *p, size_t size) {
+        if (p == nullptr)
+            return;
+        if (size == 0 || size > MAX_POOLED_SIZE) {
+            ::operator delete(p);
+            return;
+        }
+        size_t sizeClass = getSizeClass(size);
+        if (freeLists.lengths[sizeClass] >= MAX_FREE_BLOCKS) {
+            ::operator delete(p);
+            return;
+        }
+        FreeBlock *block = static_cast<FreeBlock *>(p);
+        block->next = freeLists.heads[sizeClass];
+        freeLists.heads[sizeClass] = block;
+        freeLists.lengths[sizeClass]++;
+    }
+
+    /**
+     * Returns the number of free blocks of the calling thread in the size
+     * class of the given size.
+     */
+    static size_t getNumFreeBlocks(size_t size) { return size == 0 || size > MAX_POOLED_SIZE ? 0 : freeLists.lengths[getSizeClass(size)]; }
+
+    /**
+     * Returns the free blocks of the calling thread to the heap.
+     */
+    static void clear();
+};
+
+} // namespace inet
+
+// Adds class specific allocation functions using the MemoryPool to a class.
+// The class must have a virtual destructor if it has subclasses, so that the
+// sized delete receives the size of the most derived object.
+#if INET_POOLED_ALLOCATION
+#define INET_POOLED_ALLOCATION_FUNCTIONS \
+    static void *operator new(size_t size) { return inet::MemoryPool::allocate(size); } \
+    static void operator delete(void *p, size_t size) { inet::MemoryPool::deallocate(p, size); }
+#else
+#define INET_POOLED_ALLOCATION_FUNCTIONS
+#endif
+
+#endif
+
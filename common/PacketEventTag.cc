@@ -11,6 +11,14 @@ namespace inet {
 
 void insertPacketEvent(const cModule *module, Packet *packet, int kind, simtime_t duration, PacketEvent *packetEvent)
 {
+    // mapping the region tags for update would unshare all of them, even if none is a PacketEventTag
+    bool hasEventTag = false;
+    for (int i = 0; i < packet->getNumRegionTags() && !hasEventTag; i++)
+        hasEventTag = dynamic_cast<const PacketEventTag *>(packet->getRegionTag(i).get()) != nullptr;
+    if (!hasEventTag) {
+        delete packetEvent;
+        return;
+    }
     auto simulation = module->getSimulation();
     packet->mapAllRegionTagsForUpdate<PacketEventTag>(b(0), packet->getTotalLength(), [&] (b offset, b length, const Ptr<PacketEventTag>& eventTag) {
         auto packetEventCopy = packetEvent->dup();
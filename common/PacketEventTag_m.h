@@ -130,6 +130,9 @@ class INET_API PacketEvent : public ::omnetpp::cObject
 
     virtual b getPacketLength() const;
     virtual void setPacketLength(b packetLength);
+
+  public:
+    INET_POOLED_ALLOCATION_FUNCTIONS
 };
 
 inline void doParsimPacking(omnetpp::cCommBuffer *b, const PacketEvent& obj) {obj.parsimPack(b);}
@@ -9,6 +9,7 @@
 #define __INET_PTR_H
 
 #include "inet/common/INETDefs.h"
+#include "inet/common/MemoryPool.h"
 
 #define INET_STD_SHARED_PTR        1
 #define INET_INTRUSIVE_PTR         2
@@ -111,6 +112,8 @@ Ptr<T> __checknull(const Ptr<T>& p, const char *expr, const char *file, int line
 template<typename T>
 class INET_API SharedVector : public std::vector<T>, public SharedBase<SharedVector<T>>
 {
+  public:
+    INET_POOLED_ALLOCATION_FUNCTIONS
 };
 
 } // namespace inet
@@ -49,6 +49,7 @@ simsignal_t checkSatToGroundSignal = cComponent::registerSignal("checkSatToGroun
 simsignal_t routeAddedSignal = cComponent::registerSignal("routeAdded");
 simsignal_t routeDeletedSignal = cComponent::registerSignal("routeDeleted");
 simsignal_t routeChangedSignal = cComponent::registerSignal("routeChanged");
+simsignal_t routingTableChangedSignal = cComponent::registerSignal("routingTableChanged");
 simsignal_t mrouteAddedSignal = cComponent::registerSignal("mrouteAdded");
 simsignal_t mrouteDeletedSignal = cComponent::registerSignal("mrouteDeleted");
 simsignal_t mrouteChangedSignal = cComponent::registerSignal("mrouteChanged");
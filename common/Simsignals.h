@@ -50,6 +50,7 @@ extern INET_API simsignal_t // admin
     routeAddedSignal,
     routeDeletedSignal,
     routeChangedSignal,
+    routingTableChangedSignal,
     mrouteAddedSignal,
     mrouteDeletedSignal,
     mrouteChangedSignal,
@@ -0,0 +1,58 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+
+#ifndef __INET_SIMULATIONSCOPEDSINGLETON_H
+#define __INET_SIMULATIONSCOPEDSINGLETON_H
+
+#include "inet/common/INETDefs.h"
+
+namespace inet {
+
+/**
+ * Base class of the process wide objects that keep state of the current
+ * simulation run, e.g. caches and registries shared by all modules. The
+ * instance is created on first use by getInstance(), which also adds it to
+ * the lifecycle listeners of the environment; clear() is called before a new
+ * network is set up and after the network is deleted, so nothing leaks into
+ * the next run. Subclasses may override lifecycleEvent() to react to other
+ * events as well, and they must call the base class method.
+ *
+ * Usage: class Foo : public SimulationScopedSingleton<Foo> { ... };
+ */
+template<typename T>
+class SimulationScopedSingleton : public cISimulationLifecycleListener
+{
+  private:
+    bool listenerAdded = false;
+
+  protected:
+    /**
+     * Drops the state of the current simulation run.
+     */
+    virtual void clear() = 0;
+
+  public:
+    virtual void lifecycleEvent(SimulationLifecycleEventType eventType, cObject *details) override
+    {
+        if (eventType == LF_PRE_NETWORK_SETUP || eventType == LF_POST_NETWORK_DELETE)
+            clear();
+    }
+
+    static T& getInstance()
+    {
+        static T instance;
+        if (!instance.listenerAdded) {
+            // NOTE: EXECUTE_ON_STARTUP is too early and would add the listener to StaticEnv
+            getEnvir()->addLifecycleListener(&instance);
+            instance.listenerAdded = true;
+        }
+        return instance;
+    }
+};
+
+} // namespace inet
+
+#endif
+
@@ -0,0 +1,79 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+
+#include "inet/common/TimerMultiplexer.h"
+
+namespace inet {
+
+TimerMultiplexer::TimerMultiplexer(cSimpleModule *module, const char *name) :
+    module(module),
+    message(new cMessage(name))
+{
+}
+
+TimerMultiplexer::~TimerMultiplexer()
+{
+    module->cancelAndDelete(message);
+}
+
+void TimerMultiplexer::removeStaleDeadlines()
+{
+    while (!deadlines.empty()) {
+        const Deadline& deadline = deadlines.top();
+        auto it = pendingTimers.find(deadline.timer);
+        if (it != pendingTimers.end() && it->second == deadline.sequenceNumber)
+            break;
+        deadlines.pop();
+    }
+}
+
+void TimerMultiplexer::rescheduleMessage()
+{
+    if (processing)
+        return; // done at the end of processDueTimers()
+    removeStaleDeadlines();
+    if (deadlines.empty())
+        module->cancelEvent(message);
+    else if (!message->isScheduled() || message->getArrivalTime() != deadlines.top().time) {
+        module->cancelEvent(message);
+        module->scheduleAt(deadlines.top().time, message);
+    }
+}
+
+void TimerMultiplexer::scheduleAfter(simtime_t delay, cMessage *timer)
+{
+    uint64_t sequenceNumber = nextSequenceNumber++;
+    pendingTimers[timer] = sequenceNumber;
+    deadlines.push({simTime() + delay, sequenceNumber, timer});
+    // a later deadline doesn't move the self message
+    if (!message->isScheduled() || deadlines.top().timer == timer)
+        rescheduleMessage();
+}
+
+void TimerMultiplexer::cancel(cMessage *timer)
+{
+    // the deadline becomes stale, the self message is moved only when it arrives in vain
+    pendingTimers.erase(timer);
+}
+
+void TimerMultiplexer::processDueTimers(std::function<void(cMessage *)> f)
+{
+    processing = true;
+    simtime_t now = simTime();
+    while (true) {
+        removeStaleDeadlines();
+        if (deadlines.empty() || deadlines.top().time > now)
+            break;
+        cMessage *timer = deadlines.top().timer;
+        deadlines.pop();
+        pendingTimers.erase(timer);
+        f(timer);
+    }
+    processing = false;
+    rescheduleMessage();
+}
+
+} // namespace inet
+
@@ -0,0 +1,75 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+
+#ifndef __INET_TIMERMULTIPLEXER_H
+#define __INET_TIMERMULTIPLEXER_H
+
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+#include "inet/common/INETDefs.h"
+
+namespace inet {
+
+/**
+ * Multiplexes the timers of a module over a single self message. The timer
+ * messages are never scheduled themselves: their deadlines are kept in a min
+ * heap, and only the earliest one is represented in the future event set by
+ * the self message of the multiplexer. When the self message arrives, all due
+ * timers are handed to the module in deadline order (in the order of starting
+ * them for equal deadlines) within that one event.
+ *
+ * Starting a timer that is already pending moves its deadline. The module must
+ * cancel a pending timer before deleting it.
+ */
+class INET_API TimerMultiplexer
+{
+  protected:
+    struct Deadline {
+        simtime_t time;
+        uint64_t sequenceNumber; // identifies the deadline of a timer, older ones are stale
+        cMessage *timer;
+
+        bool operator>(const Deadline& other) const {
+            return time != other.time ? time > other.time : sequenceNumber > other.sequenceNumber;
+        }
+    };
+
+    cSimpleModule *module;
+    cMessage *message; // the only scheduled self message, due at the earliest deadline
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> deadlines; // may contain stale deadlines
+    std::unordered_map<cMessage *, uint64_t> pendingTimers; // timer -> sequence number of its current deadline
+    uint64_t nextSequenceNumber = 0;
+    bool processing = false;
+
+  protected:
+    void removeStaleDeadlines();
+    void rescheduleMessage();
+
+  public:
+    TimerMultiplexer(cSimpleModule *module, const char *name);
+    ~TimerMultiplexer();
+
+    bool isMultiplexerMessage(const cMessage *msg) const { return msg == message; }
+    bool isPending(cMessage *timer) const { return pendingTimers.find(timer) != pendingTimers.end(); }
+    int getNumPendingTimers() const { return pendingTimers.size(); }
+
+    void scheduleAfter(simtime_t delay, cMessage *timer);
+    void cancel(cMessage *timer);
+
+    /**
+     * Removes the due timers and calls the function for each of them. The
+     * function may start and cancel timers, the ones becoming due are also
+     * processed. Call it when the self message of the multiplexer arrives.
+     */
+    void processDueTimers(std::function<void(cMessage *)> f);
+};
+
+} // namespace inet
+
+#endif
+
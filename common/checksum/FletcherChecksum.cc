@@ -0,0 +1,148 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+
+#include "inet/common/checksum/FletcherChecksum.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace inet {
+
+namespace {
+
+// the 32 bit running sums cannot overflow within this many octets (c1 grows quadratically)
+const size_t MAX_SCALAR_RUN = 4096;
+
+inline unsigned int mod255(int64_t value)
+{
+    int64_t result = value % 255;
+    return (unsigned int)(result < 0 ? result + 255 : result);
+}
+
+#if defined(__SSE2__)
+
+inline uint64_t horizontalSum64(__m128i v)
+{
+    return (uint64_t)_mm_cvtsi128_si32(v) + ((uint64_t)_mm_cvtsi128_si32(_mm_srli_si128(v, 8)));
+}
+
+inline uint64_t horizontalSum32(__m128i v)
+{
+    v = _mm_add_epi32(v, _mm_srli_si128(v, 8));
+    v = _mm_add_epi32(v, _mm_srli_si128(v, 4));
+    return (uint32_t)_mm_cvtsi128_si32(v);
+}
+
+/**
+ * Processes length / 16 blocks of 16 octets, returns the number of octets consumed.
+ * For a block of octets b[0..15], c0 grows by sum(b[j]) and c1 grows by
+ * 16 * c0 + sum((16 - j) * b[j]).
+ */
+size_t blockSums(const uint8_t *data, size_t length, unsigned int& c0, unsigned int& c1)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i weightsLow = _mm_set_epi16(9, 10, 11, 12, 13, 14, 15, 16);
+    const __m128i weightsHigh = _mm_set_epi16(1, 2, 3, 4, 5, 6, 7, 8);
+    size_t consumed = 0;
+    while (length - consumed >= 16) {
+        // c1 is reduced at least every 256 blocks, so that none of the accumulators overflow
+        size_t blockCount = std::min((length - consumed) / 16, (size_t)256);
+        __m128i sum = zero; // two 64 bit lanes: sum of octets
+        __m128i prefixSum = zero; // two 64 bit lanes: sum of the octet sums before each block
+        __m128i weightedSum = zero; // four 32 bit lanes: sum of weighted octets within the blocks
+        for (size_t i = 0; i < blockCount; i++) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + consumed + 16 * i));
+            prefixSum = _mm_add_epi64(prefixSum, sum);
+            sum = _mm_add_epi64(sum, _mm_sad_epu8(v, zero));
+            __m128i low = _mm_unpacklo_epi8(v, zero);
+            __m128i high = _mm_unpackhi_epi8(v, zero);
+            weightedSum = _mm_add_epi32(weightedSum, _mm_add_epi32(_mm_madd_epi16(low, weightsLow), _mm_madd_epi16(high, weightsHigh)));
+        }
+        uint64_t blockC0 = horizontalSum64(sum);
+        uint64_t blockC1 = 16 * horizontalSum64(prefixSum) + horizontalSum32(weightedSum);
+        c1 = mod255((int64_t)c1 + (int64_t)(16 * blockCount) * c0 + (int64_t)(blockC1 % 255));
+        c0 = mod255((int64_t)c0 + (int64_t)(blockC0 % 255));
+        consumed += 16 * blockCount;
+    }
+    return consumed;
+}
+
+#endif
+
+} // namespace
+
+void FletcherChecksum::sums(const uint8_t *data, size_t length, unsigned int& c0, unsigned int& c1)
+{
+    c0 = 0;
+    c1 = 0;
+    size_t i = 0;
+#if defined(__SSE2__)
+    i = blockSums(data, length, c0, c1);
+#endif
+    while (i < length) {
+        size_t end = std::min(length, i + MAX_SCALAR_RUN);
+        uint32_t s0 = c0, s1 = c1;
+        for (; i < end; i++) {
+            s0 += data[i];
+            s1 += s0;
+        }
+        c0 = s0 % 255;
+        c1 = s1 % 255;
+    }
+}
+
+uint16_t FletcherChecksum::checksumFromSums(int64_t c0, int64_t c1, size_t length, size_t checksumOffset)
+{
+    int64_t weight = length - checksumOffset; // weight of the first checksum octet in c1
+    unsigned int x = mod255((weight - 1) * c0 - c1);
+    unsigned int y = mod255(c1 - weight * c0);
+    // zero is represented as 255, a zero checksum field means that no checksum is present
+    if (x == 0)
+        x = 255;
+    if (y == 0)
+        y = 255;
+    return (uint16_t)((x << 8) | y);
+}
+
+uint16_t FletcherChecksum::checksum(const uint8_t *data, size_t length, size_t checksumOffset)
+{
+    ASSERT(checksumOffset + 2 <= length);
+    unsigned int c0, c1;
+    sums(data, length, c0, c1);
+    // remove the contribution of the checksum octets
+    int64_t weight = length - checksumOffset;
+    int64_t x = data[checksumOffset];
+    int64_t y = data[checksumOffset + 1];
+    return checksumFromSums((int64_t)c0 - x - y, (int64_t)c1 - weight * x - (weight - 1) * y, length, checksumOffset);
+}
+
+bool FletcherChecksum::verify(const uint8_t *data, size_t length)
+{
+    unsigned int c0, c1;
+    sums(data, length, c0, c1);
+    return c0 == 0 && c1 == 0;
+}
+
+uint16_t FletcherChecksum::update(uint16_t checksum, size_t length, size_t checksumOffset, size_t changeOffset, const uint8_t *oldBytes, const uint8_t *newBytes, size_t changeLength)
+{
+    ASSERT(changeOffset + changeLength <= checksumOffset || changeOffset >= checksumOffset + 2);
+    ASSERT(changeOffset + changeLength <= length);
+    // recover the sums of the data with zero checksum octets from the valid checksum
+    int64_t weight = length - checksumOffset;
+    int64_t x = checksum >> 8;
+    int64_t y = checksum & 0xFF;
+    int64_t c0 = -(x + y);
+    int64_t c1 = -(weight * x + (weight - 1) * y);
+    for (size_t i = 0; i < changeLength; i++) {
+        int64_t delta = (int64_t)newBytes[i] - oldBytes[i];
+        c0 += delta;
+        c1 += (int64_t)(length - changeOffset - i) * delta;
+    }
+    return checksumFromSums(mod255(c0), mod255(c1), length, checksumOffset);
+}
+
+} // namespace inet
+
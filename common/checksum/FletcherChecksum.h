@@ -0,0 +1,52 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+
+#ifndef __INET_FLETCHERCHECKSUM_H
+#define __INET_FLETCHERCHECKSUM_H
+
+#include "inet/common/INETDefs.h"
+
+namespace inet {
+
+/**
+ * Calculates the Fletcher checksum defined in RFC 905 Annex B (ISO 8473),
+ * which is used e.g. as the OSPF LS checksum (RFC 2328 Section 12.1.7).
+ *
+ * The checksum is two octets placed at a given offset of the checksummed
+ * data, chosen so that both Fletcher sums of the complete data are zero.
+ */
+class INET_API FletcherChecksum
+{
+  private:
+    static void sums(const uint8_t *data, size_t length, unsigned int& c0, unsigned int& c1);
+    static uint16_t checksumFromSums(int64_t c0, int64_t c1, size_t length, size_t checksumOffset);
+
+  public:
+    /**
+     * Returns the checksum for the data, the two octets at checksumOffset are
+     * treated as zero. The result is in host byte order, its high octet goes
+     * to checksumOffset.
+     */
+    static uint16_t checksum(const uint8_t *data, size_t length, size_t checksumOffset);
+    static uint16_t checksum(const std::vector<uint8_t>& data, size_t checksumOffset) { return checksum(data.data(), data.size(), checksumOffset); }
+
+    /**
+     * Returns true if the data (including the checksum octets) checksums to zero.
+     */
+    static bool verify(const uint8_t *data, size_t length);
+    static bool verify(const std::vector<uint8_t>& data) { return verify(data.data(), data.size()); }
+
+    /**
+     * Updates a valid checksum after changeLength octets starting at changeOffset
+     * were changed from oldBytes to newBytes, without touching the rest of the data.
+     * The changed octets must not overlap with the checksum octets.
+     */
+    static uint16_t update(uint16_t checksum, size_t length, size_t checksumOffset, size_t changeOffset, const uint8_t *oldBytes, const uint8_t *newBytes, size_t changeLength);
+};
+
+} // namespace inet
+
+#endif
+
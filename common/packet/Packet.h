@@ -11,6 +11,7 @@
 #include <functional>
 
 #include "inet/common/IPrintableObject.h"
+#include "inet/common/MemoryPool.h"
 #include "inet/common/TagBase.h"
 #include "inet/common/packet/chunk/BitsChunk.h"
 #include "inet/common/packet/chunk/BytesChunk.h"
@@ -164,6 +165,8 @@ class INET_API Packet : public cPacket, public IPrintableObject, public ITaggedO
     explicit Packet(const char *name = nullptr, short kind = 0);
     Packet(const char *name, const Ptr<const Chunk>& content);
     Packet(const Packet& other);
+
+    INET_POOLED_ALLOCATION_FUNCTIONS
     //@}
 
     /** @name Supported cPacket interface functions */
@@ -13,6 +13,7 @@
 #include "inet/common/IPrintableObject.h"
 #include "inet/common/MemoryInputStream.h"
 #include "inet/common/MemoryOutputStream.h"
+#include "inet/common/MemoryPool.h"
 #include "inet/common/Ptr.h"
 #include "inet/common/TemporarySharedPtr.h"
 #include "inet/common/Units.h"
@@ -431,6 +432,8 @@ class INET_API Chunk : public cObject, public SharedBase<Chunk>, public IPrintab
     Chunk();
     Chunk(const Chunk& other);
 
+    INET_POOLED_ALLOCATION_FUNCTIONS
+
     /**
      * Returns a mutable copy of this chunk in a shared pointer.
      */
@@ -330,11 +330,20 @@ void Ppp::refreshDisplay() const
 
 void Ppp::encapsulate(Packet *packet)
 {
-    auto pppHeader = makeShared<PppHeader>();
-    pppHeader->setProtocol(ProtocolGroup::pppprotocol.getProtocolNumber(packet->getTag<PacketProtocolTag>()->getProtocol()));
-    packet->insertAtFront(pppHeader);
-    auto pppTrailer = makeShared<PppTrailer>();
-    packet->insertAtBack(pppTrailer);
+    int protocolNumber = ProtocolGroup::pppprotocol.getProtocolNumber(packet->getTag<PacketProtocolTag>()->getProtocol());
+    if (txPppHeader == nullptr || txPppHeader->getProtocol() != protocolNumber) {
+        auto header = makeShared<PppHeader>();
+        header->setProtocol(protocolNumber);
+        header->markImmutable();
+        txPppHeader = header;
+    }
+    packet->insertAtFront(txPppHeader);
+    if (txPppTrailer == nullptr) {
+        auto trailer = makeShared<PppTrailer>();
+        trailer->markImmutable();
+        txPppTrailer = trailer;
+    }
+    packet->insertAtBack(txPppTrailer);
     packet->addTagIfAbsent<PacketProtocolTag>()->setProtocol(&Protocol::ppp);
 }
 
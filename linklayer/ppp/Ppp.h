@@ -34,6 +34,10 @@ class INET_API Ppp : public MacProtocolBase, public queueing::IActivePacketSink
     // saved current transmission
     Packet *curTxPacket = nullptr;
 
+    // the framing chunks are immutable, so they are shared by the frames
+    Ptr<const PppHeader> txPppHeader; // of the last encapsulated protocol
+    Ptr<const PppTrailer> txPppTrailer;
+
     std::string oldConnColor;
 
     // statistics
@@ -100,6 +100,11 @@ class INET_API L3Address
 
     bool matches(const L3Address& other, int prefixLength) const;
 
+    /**
+     * Returns a hash value of the address, equal addresses have equal hash values.
+     */
+    size_t getHash() const { return (size_t)(hi * 0x9E3779B97F4A7C15ULL) ^ (size_t)lo; }
+
     MacAddress mapToMulticastMacAddress() const;
 
     static const char *getTypeName(AddressType t);
@@ -159,6 +159,22 @@ class INET_API IIpv4RoutingTable : public IRoutingTable
     virtual bool deleteRoute(Ipv4Route *entry) = 0;
     using IRoutingTable::deleteRoute;
 
+    /**
+     * Starts a batch of unicast route changes. Until the matching commitUpdate(),
+     * added and changed routes are not sorted into place, the routing cache is
+     * not invalidated, and the routeAdded/routeDeleted/routeChanged signals
+     * are held back. Lookups remain correct inside the batch. Updates may be
+     * nested, only the outermost commitUpdate() applies the batch.
+     */
+    virtual void beginUpdate() = 0;
+
+    /**
+     * Applies the batch of route changes started by beginUpdate(): sorts the
+     * routes once, invalidates the routing cache, emits the held back signals,
+     * and then a single routingTableChanged signal with the number of changes.
+     */
+    virtual void commitUpdate() = 0;
+
     /**
      * Returns the kth multicast route.
      */
@@ -46,6 +46,7 @@
  * @sqsq
  */
 #include "inet/routing/ospfv2/router/Ospfv2Common.h"
+#include "inet/routing/ospfv2/router/Ospfv2ResultFiles.h"
 #include "inet/queueing/queue/PacketQueue.h"
 #include "inet/common/ModuleAccess.h"
 #include "inet/routing/ospfv2/Ospfv2.h"
@@ -62,38 +63,12 @@ Define_Module(Ipv4);
 // a multicast cimek eseten hianyoznak bizonyos NetFilter hook-ok
 // a local interface-k hasznalata eseten szinten hianyozhatnak bizonyos NetFilter hook-ok
 
-std::ofstream Ipv4::ofs;
-
 Ipv4::Ipv4()
 {
-    /*
-     * @sqsq
-     */
-    std::srand(this->getId());
-    if (!ofs.is_open()) {
-        std::string filename = "/home/sqsq/Desktop/"
-                "sat-ospf/inet/examples/ospfv2/sqsqtest/results/";
-        filename += EXPERIMENT_NAME;
-        filename += "/";
-
-        filename += IS_OSPF ? "OSPF" : std::to_string(SQSQ_HOP);
-
-        filename += "/";
-        filename += getEnvir()->getConfigEx()->getActiveConfigName();
-        filename += "/dropPacketRaw.csv";
-        ofs.open(filename, std::ios::app);
-    }
 }
 
 Ipv4::~Ipv4()
 {
-    /*
-     * @sqsq
-     */
-    if (ofs.is_open()) {
-        ofs.close();
-    }
-
     for (auto it : socketIdToSocketDescriptor)
         delete it.second;
     flush();
@@ -118,6 +93,7 @@ void Ipv4::initialize(int stage)
         defaultMCTimeToLive = par("multicastTimeToLive");
         fragmentTimeoutTime = par("fragmentTimeout");
         limitedBroadcast = par("limitedBroadcast");
+        cutThroughForwarding = par("cutThroughForwarding");
         directBroadcastInterfaces = par("directBroadcastInterfaces").stdstringValue();
 
         directBroadcastInterfaceMatcher.setPattern(directBroadcastInterfaces.c_str(), false, true, false);
@@ -297,7 +273,7 @@ void Ipv4::handleIncomingDatagram(Packet *packet)
     // "Prerouting"
     //
 
-    const auto& ipv4Header = packet->peekAtFront<Ipv4Header>();
+    auto ipv4Header = packet->peekAtFront<Ipv4Header>();
     packet->addTagIfAbsent<NetworkProtocolInd>()->setProtocol(&Protocol::ipv4);
     packet->addTagIfAbsent<NetworkProtocolInd>()->setNetworkProtocolHeader(ipv4Header);
 
@@ -334,6 +310,8 @@ void Ipv4::handleIncomingDatagram(Packet *packet)
     }
 
     EV_DETAIL << "Received datagram `" << ipv4Header->getName() << "' with dest=" << ipv4Header->getDestAddress() << "\n";
+    // a reference to the header would prevent decrementing the TTL in place, see decrementTimeToLiveInPlace()
+    ipv4Header = nullptr;
 
     if (datagramPreRoutingHook(packet) == INetfilter::IHook::ACCEPT)
         preroutingFinish(packet);
@@ -341,20 +319,57 @@ void Ipv4::handleIncomingDatagram(Packet *packet)
 
 Packet *Ipv4::prepareForForwarding(Packet *packet) const
 {
+    if (cutThroughForwarding && decrementTimeToLiveInPlace(packet))
+        return packet;
     const auto& ipv4Header = removeNetworkProtocolHeader<Ipv4Header>(packet);
     ipv4Header->setTimeToLive(ipv4Header->getTimeToLive() - 1);
     insertNetworkProtocolHeader(packet, Protocol::ipv4, ipv4Header);
     return packet;
 }
 
+bool Ipv4::decrementTimeToLiveInPlace(Packet *packet) const
+{
+    // the header is only changed in place if nothing but the content of this packet (and its
+    // NetworkProtocolInd) refers to it, otherwise it is copied as usual (e.g. multicast copies,
+    // the frame still being transmitted); the packet is not changed in that case
+    if (const_cast<Chunk *>(packet->getContent())->shared_from_this().use_count() != 2)
+        return false;
+    Ptr<const Ipv4Header> ipv4Header = packet->peekAtFront<Ipv4Header>();
+    long numReferences = 2; // the content and ipv4Header
+    if (auto networkProtocolInd = packet->findTag<NetworkProtocolInd>())
+        if (networkProtocolInd->getNetworkProtocolHeader() == ipv4Header)
+            numReferences++;
+    if (ipv4Header.use_count() != numReferences)
+        return false;
+    auto header = const_cast<Ipv4Header *>(ipv4Header.get());
+    ipv4Header = nullptr;
+    // same tags and content as after removing and inserting the header
+    packet->removeTagIfPresent<NetworkProtocolInd>();
+    packet->removeTagIfPresent<PacketProtocolTag>();
+    packet->trim();
+    ASSERT(packet->peekAtFront<Ipv4Header>().get() == header);
+    header->markMutableIfExclusivelyOwned();
+    header->setTimeToLive(header->getTimeToLive() - 1);
+    header->markImmutable();
+    auto networkProtocolInd = packet->addTag<NetworkProtocolInd>();
+    networkProtocolInd->setProtocol(&Protocol::ipv4);
+    networkProtocolInd->setNetworkProtocolHeader(packet->peekAtFront<Ipv4Header>());
+    packet->addTag<PacketProtocolTag>()->setProtocol(&Protocol::ipv4);
+    return true;
+}
+
 void Ipv4::preroutingFinish(Packet *packet)
 {
     const NetworkInterface *fromIE = ift->getInterfaceById(packet->getTag<InterfaceInd>()->getInterfaceId());
     Ipv4Address nextHopAddr = getNextHop(packet);
 
-    const auto& ipv4Header = packet->peekAtFront<Ipv4Header>();
+    auto ipv4Header = packet->peekAtFront<Ipv4Header>();
     ASSERT(ipv4Header);
     Ipv4Address destAddr = ipv4Header->getDestAddress();
+    IpProtocolId protocolId = ipv4Header->getProtocolId();
+    short timeToLive = ipv4Header->getTimeToLive();
+    // a reference to the header would prevent decrementing the TTL in place, see decrementTimeToLiveInPlace()
+    ipv4Header = nullptr;
 
     // route packet
 
@@ -365,7 +380,7 @@ void Ipv4::preroutingFinish(Packet *packet)
         // check for local delivery
         // Note: multicast routers will receive IGMP datagrams even if their interface is not joined to the group
         if (fromIE->getProtocolData<Ipv4InterfaceData>()->isMemberOfMulticastGroup(destAddr) ||
-            (rt->isMulticastForwardingEnabled() && ipv4Header->getProtocolId() == IP_PROT_IGMP))
+            (rt->isMulticastForwardingEnabled() && protocolId == IP_PROT_IGMP))
             reassembleAndDeliver(packet->dup());
         else
             EV_WARN << "Skip local delivery of multicast datagram (input interface not in multicast group)\n";
@@ -379,7 +394,7 @@ void Ipv4::preroutingFinish(Packet *packet)
             EV_WARN << "Skip forwarding of multicast datagram (packet is link-local)\n";
             delete packet;
         }
-        else if (ipv4Header->getTimeToLive() <= 1) { // TTL before decrement
+        else if (timeToLive <= 1) { // TTL before decrement
             EV_WARN << "Skip forwarding of multicast datagram (TTL reached 0)\n";
             delete packet;
         }
@@ -579,7 +594,8 @@ void Ipv4::routeUnicastPacket(Packet *packet)
         /*
          * sqsq
          */
-        if (ofs.is_open() && RECORD_CSV) {
+        if (RECORD_CSV) {
+            std::ostream& ofs = ospfv2::Ospfv2ResultFiles::getFile("dropPacketRaw.csv");
             ofs << getEnvir()->getConfigEx()->getActiveConfigName() << ",";
             ofs << SQSQ_HOP << ",";
             ofs << this->getParentModule()->getFullPath() << ",";
@@ -720,7 +736,7 @@ void Ipv4::routeUnicastPacket(Packet *packet)
                 std::string interfaceName = destIE->getInterfaceName();
                 int direction = interfaceName[interfaceName.length() - 1] - '0';
                 double chi = getChi(direction);
-                double randomValue = static_cast<double>(std::rand()) / RAND_MAX;
+                double randomValue = dblrand();
                 if (randomValue < chi) {
                     std::vector<Ipv4Route *> removedRoutes;
                     rt->removeRoute(re);
@@ -782,7 +798,8 @@ void Ipv4::routeUnicastPacket(Packet *packet)
 
             numUnroutable++;
 
-            if (ofs.is_open() && RECORD_CSV) {
+            if (RECORD_CSV) {
+                std::ostream& ofs = ospfv2::Ospfv2ResultFiles::getFile("dropPacketRaw.csv");
                 ofs << getEnvir()->getConfigEx()->getActiveConfigName() << ",";
                 ofs << SQSQ_HOP << ",";
                 ofs << this->getParentModule()->getFullPath() << ",";
@@ -799,7 +816,8 @@ void Ipv4::routeUnicastPacket(Packet *packet)
                 std::cout << "stub, dropping packet" <<
                         this->getParentModule()->getFullPath() << " " << simTime() << endl;
             }
-            if (ofs.is_open() && RECORD_CSV) {
+            if (RECORD_CSV) {
+                std::ostream& ofs = ospfv2::Ospfv2ResultFiles::getFile("dropPacketRaw.csv");
                 ofs << getEnvir()->getConfigEx()->getActiveConfigName() << ",";
                 ofs << SQSQ_HOP << ",";
                 ofs << this->getParentModule()->getFullPath() << ",";
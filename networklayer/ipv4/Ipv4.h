@@ -75,6 +75,7 @@ class INET_API Ipv4 : public OperationalBase, public NetfilterBase, public INetw
     int defaultMCTimeToLive = -1;
     simtime_t fragmentTimeoutTime;
     bool limitedBroadcast = false;
+    bool cutThroughForwarding = false;
     std::string directBroadcastInterfaces = "";
 
     cPatternMatcher directBroadcastInterfaceMatcher;
@@ -99,7 +100,6 @@ class INET_API Ipv4 : public OperationalBase, public NetfilterBase, public INetw
     /*
      * @sqsq
      */
-    static std::ofstream ofs;
     double chiArray[4] = {0.0, 0.0, 0.0, 0.0};  // 要往上下左右4个方向转发时的流量偏转值
 
 
@@ -225,6 +225,7 @@ class INET_API Ipv4 : public OperationalBase, public NetfilterBase, public INetw
     virtual void sendIcmpError(Packet *packet, int inputInterfaceId, IcmpType type, IcmpCode code);
 
     virtual Packet *prepareForForwarding(Packet *packet) const;
+    virtual bool decrementTimeToLiveInPlace(Packet *packet) const;
 
   public:
     Ipv4();
@@ -0,0 +1,290 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#include "inet/networklayer/ipv4/Ipv4ForwardingObserver.h"
+
+#include <algorithm>
+
+#include "inet/common/ModuleAccess.h"
+#include "inet/common/Simsignals.h"
+#include "inet/common/Topology.h"
+#include "inet/networklayer/common/L3AddressResolver.h"
+#include "inet/networklayer/ipv4/Ipv4InterfaceData.h"
+
+namespace inet {
+
+Define_Module(Ipv4ForwardingObserver);
+
+static const size_t MAX_CHANGED_PREFIXES = 16;
+
+simsignal_t Ipv4ForwardingObserver::convergenceTimeSignal = registerSignal("convergenceTime");
+simsignal_t Ipv4ForwardingObserver::loopDurationSignal = registerSignal("loopDuration");
+simsignal_t Ipv4ForwardingObserver::loopCountSignal = registerSignal("loopCount");
+simsignal_t Ipv4ForwardingObserver::blackHoleCountSignal = registerSignal("blackHoleCount");
+
+Ipv4ForwardingObserver::~Ipv4ForwardingObserver()
+{
+    cancelAndDelete(evaluateTimer);
+}
+
+void Ipv4ForwardingObserver::initialize(int stage)
+{
+    if (stage == INITSTAGE_LOCAL) {
+        if (getEnvir()->getParsimNumPartitions() > 1)
+            throw cRuntimeError("The forwarding state observer needs all routing tables in one process, it cannot be used with parallel simulation");
+        evaluateTimer = new cMessage("evaluate");
+        subjectModule = getModuleByPath(par("subjectModule"));
+        if (subjectModule == nullptr)
+            throw cRuntimeError("Module not found on path '%s' defined by par 'subjectModule'", par("subjectModule").stringValue());
+        subjectModule->subscribe(routeAddedSignal, this);
+        subjectModule->subscribe(routeDeletedSignal, this);
+        subjectModule->subscribe(routeChangedSignal, this);
+        WATCH(blackHoleCount);
+        WATCH(inconsistentSince);
+    }
+}
+
+void Ipv4ForwardingObserver::preDelete(cComponent *root)
+{
+    if (subjectModule != nullptr) {
+        subjectModule->unsubscribe(routeAddedSignal, this);
+        subjectModule->unsubscribe(routeDeletedSignal, this);
+        subjectModule->unsubscribe(routeChangedSignal, this);
+        subjectModule = nullptr;
+    }
+}
+
+void Ipv4ForwardingObserver::handleMessage(cMessage *msg)
+{
+    if (msg == evaluateTimer) {
+        if (!topologyExtracted)
+            extractTopology();
+        evaluateChanges();
+    }
+    else
+        throw cRuntimeError("Unknown message");
+}
+
+void Ipv4ForwardingObserver::refreshDisplay() const
+{
+    char buf[80];
+    sprintf(buf, "loops: %d\nblack holes: %d", (int)loops.size(), blackHoleCount);
+    getDisplayString().setTagArg("t", 0, buf);
+}
+
+void Ipv4ForwardingObserver::receiveSignal(cComponent *source, simsignal_t signal, cObject *obj, cObject *details)
+{
+    Enter_Method("%s", cComponent::getSignalName(signal));
+
+    // routing tables are usually changed in bursts (e.g. a complete OSPF rebuild),
+    // so the changed nodes are only collected here and evaluated once at the end of the event
+    cModule *node = findContainingNode(check_and_cast<cModule *>(source));
+    if (node == nullptr)
+        return;
+    // an added or deleted route can only change the next hop towards the destinations it covers;
+    // the old prefix of a changed route is not known, and a long list is not worth matching
+    NodeChange& change = changedNodes[node->getId()];
+    auto route = dynamic_cast<Ipv4Route *>(obj);
+    if (route == nullptr || signal == routeChangedSignal || change.prefixes.size() >= MAX_CHANGED_PREFIXES)
+        change.allDestinations = true;
+    else if (!change.allDestinations)
+        change.prefixes.push_back(std::make_pair(route->getDestination(), route->getNetmask()));
+    if (!evaluateTimer->isScheduled())
+        scheduleAt(simTime(), evaluateTimer);
+}
+
+void Ipv4ForwardingObserver::extractTopology()
+{
+    Topology topology;
+    topology.extractByProperty("networkNode");
+
+    L3AddressResolver addressResolver;
+    for (int i = 0; i < topology.getNumNodes(); i++) {
+        cModule *module = topology.getNode(i)->getModule();
+        Node node;
+        node.module = module;
+        node.routingTable = addressResolver.findIpv4RoutingTableOf(module);
+        node.interfaceTable = addressResolver.findInterfaceTableOf(module);
+        if (node.routingTable == nullptr || node.interfaceTable == nullptr)
+            continue;
+        nodeIndexByModuleId[module->getId()] = nodes.size();
+        nodes.push_back(node);
+    }
+
+    // any address of a node identifies the node, the first non-loopback one is used as its destination
+    destinations.resize(nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        IInterfaceTable *ift = nodes[i].interfaceTable;
+        for (int j = 0; j < ift->getNumInterfaces(); j++) {
+            NetworkInterface *ie = ift->getInterface(j);
+            auto ipv4Data = ie->findProtocolData<Ipv4InterfaceData>();
+            if (ipv4Data == nullptr || ipv4Data->getIPAddress().isUnspecified())
+                continue;
+            nodeIndexByAddress[ipv4Data->getIPAddress()] = i;
+            if (!ie->isLoopback() && destinations[i].isUnspecified())
+                destinations[i] = ipv4Data->getIPAddress();
+        }
+    }
+
+    // routes without a gateway on point-to-point links are resolved by the link itself
+    for (int i = 0; i < topology.getNumNodes(); i++) {
+        Topology::Node *topologyNode = topology.getNode(i);
+        auto it = nodeIndexByModuleId.find(topologyNode->getModuleId());
+        if (it == nodeIndexByModuleId.end())
+            continue;
+        Node& node = nodes[it->second];
+        for (int j = 0; j < topologyNode->getNumOutLinks(); j++) {
+            Topology::Link *link = topologyNode->getLinkOut(j);
+            auto peerIt = nodeIndexByModuleId.find(link->getLinkOutRemoteNode()->getModuleId());
+            NetworkInterface *ie = node.interfaceTable->findInterfaceByNodeOutputGateId(link->getLinkOutLocalGateId());
+            if (peerIt != nodeIndexByModuleId.end() && ie != nullptr && ie->isPointToPoint())
+                node.peerByInterfaceId[ie->getInterfaceId()] = peerIt->second;
+        }
+    }
+
+    nextHops.assign(nodes.size(), std::vector<int>(nodes.size(), UNKNOWN));
+    visitMarks.assign(nodes.size(), std::vector<unsigned int>(nodes.size(), 0));
+    for (auto& node : nodes)
+        changedNodes[node.module->getId()].allDestinations = true;
+    topologyExtracted = true;
+    EV_INFO << "Observing the forwarding state of " << nodes.size() << " nodes" << endl;
+}
+
+int Ipv4ForwardingObserver::computeNextHop(int nodeIndex, int destinationIndex) const
+{
+    if (nodeIndex == destinationIndex)
+        return DELIVERED;
+    const Node& node = nodes[nodeIndex];
+    const Ipv4Address& destination = destinations[destinationIndex];
+    const Ipv4Route *route = node.routingTable->findBestMatchingRoute(destination);
+    if (route == nullptr)
+        return NO_ROUTE;
+    const NetworkInterface *ie = route->getInterface();
+    if (ie == nullptr || ie->isLoopback() || !ie->isUp())
+        return NO_ROUTE;
+    Ipv4Address nextHopAddress = route->getGateway();
+    if (!nextHopAddress.isUnspecified()) {
+        auto it = nodeIndexByAddress.find(nextHopAddress);
+        return it != nodeIndexByAddress.end() ? it->second : NO_ROUTE;
+    }
+    auto it = node.peerByInterfaceId.find(ie->getInterfaceId());
+    if (it != node.peerByInterfaceId.end())
+        return it->second;
+    // directly connected multi-access network
+    return destinationIndex;
+}
+
+bool Ipv4ForwardingObserver::isAffected(const NodeChange& change, int destinationIndex) const
+{
+    if (change.allDestinations)
+        return true;
+    const Ipv4Address& destination = destinations[destinationIndex];
+    for (auto& prefix : change.prefixes)
+        if (Ipv4Address::maskedAddrAreEqual(destination, prefix.first, prefix.second))
+            return true;
+    return false;
+}
+
+void Ipv4ForwardingObserver::evaluateChanges()
+{
+    // update the entries of the changed nodes towards the affected destinations only
+    std::vector<std::pair<int, int>> changedEntries;
+    std::set<int> changedDestinations;
+    for (auto& elem : changedNodes) {
+        auto it = nodeIndexByModuleId.find(elem.first);
+        if (it == nodeIndexByModuleId.end())
+            continue;
+        int nodeIndex = it->second;
+        for (size_t destinationIndex = 0; destinationIndex < destinations.size(); destinationIndex++) {
+            if (destinations[destinationIndex].isUnspecified() || !isAffected(elem.second, destinationIndex))
+                continue;
+            int nextHop = computeNextHop(nodeIndex, destinationIndex);
+            int& entry = nextHops[nodeIndex][destinationIndex];
+            if (nextHop == entry)
+                continue;
+            if (entry == NO_ROUTE)
+                blackHoleCount--;
+            if (nextHop == NO_ROUTE)
+                blackHoleCount++;
+            entry = nextHop;
+            changedEntries.push_back(std::make_pair(nodeIndex, destinationIndex));
+            changedDestinations.insert(destinationIndex);
+        }
+    }
+    changedNodes.clear();
+    if (changedEntries.empty())
+        return;
+
+    // a loop can only be broken by changing one of its entries
+    int oldLoopCount = loops.size();
+    for (auto it = loops.begin(); it != loops.end();) {
+        if (changedDestinations.count(it->first.first) == 0 || isLoopIntact(it->first.first, it->second))
+            ++it;
+        else {
+            EV_INFO << "Forwarding loop towards " << destinations[it->first.first] << " resolved after " << simTime() - it->second.startTime << endl;
+            emit(loopDurationSignal, simTime() - it->second.startTime);
+            it = loops.erase(it);
+        }
+    }
+
+    // and a new loop must contain a changed entry, so walking from the changed entries finds all of them
+    std::vector<int> path;
+    batchStartMark = walkCount;
+    for (auto& changedEntry : changedEntries)
+        walkFrom(changedEntry.first, changedEntry.second, path);
+
+    if ((int)loops.size() != oldLoopCount)
+        emit(loopCountSignal, (int)loops.size());
+    emit(blackHoleCountSignal, blackHoleCount);
+
+    bool consistent = loops.empty() && blackHoleCount == 0;
+    if (!consistent && inconsistentSince < 0)
+        inconsistentSince = simTime();
+    else if (consistent && inconsistentSince >= 0) {
+        EV_INFO << "Forwarding state converged after " << simTime() - inconsistentSince << endl;
+        emit(convergenceTimeSignal, simTime() - inconsistentSince);
+        inconsistentSince = -1;
+    }
+}
+
+void Ipv4ForwardingObserver::walkFrom(int nodeIndex, int destinationIndex, std::vector<int>& path)
+{
+    // every walk of the same batch gets a new mark; meeting a mark of an earlier
+    // walk of the batch means that the rest of the path has already been checked
+    unsigned int mark = ++walkCount;
+    std::vector<unsigned int>& marks = visitMarks[destinationIndex];
+    path.clear();
+    int current = nodeIndex;
+    while (current >= 0) {
+        if (marks[current] == mark) {
+            // the path has run into itself: the cycle starts at the first occurrence of current
+            auto start = std::find(path.begin(), path.end(), current);
+            Loop loop;
+            loop.startTime = simTime();
+            loop.nodes.assign(start, path.end());
+            std::rotate(loop.nodes.begin(), std::min_element(loop.nodes.begin(), loop.nodes.end()), loop.nodes.end());
+            LoopKey key(destinationIndex, loop.nodes.front());
+            if (loops.find(key) == loops.end()) {
+                EV_WARN << "Forwarding loop of " << loop.nodes.size() << " nodes towards " << destinations[destinationIndex] << " at " << nodes[current].module->getFullPath() << endl;
+                loops[key] = loop;
+            }
+            return;
+        }
+        if (marks[current] > batchStartMark)
+            return;
+        marks[current] = mark;
+        path.push_back(current);
+        current = nextHops[current][destinationIndex];
+    }
+}
+
+bool Ipv4ForwardingObserver::isLoopIntact(int destinationIndex, const Loop& loop) const
+{
+    for (size_t i = 0; i < loop.nodes.size(); i++)
+        if (nextHops[loop.nodes[i]][destinationIndex] != loop.nodes[(i + 1) % loop.nodes.size()])
+            return false;
+    return true;
+}
+
+} // namespace inet
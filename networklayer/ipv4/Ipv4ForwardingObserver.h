@@ -0,0 +1,103 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#ifndef __INET_IPV4FORWARDINGOBSERVER_H
+#define __INET_IPV4FORWARDINGOBSERVER_H
+
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "inet/networklayer/contract/IInterfaceTable.h"
+#include "inet/networklayer/ipv4/IIpv4RoutingTable.h"
+
+namespace inet {
+
+/**
+ * Network-wide observer of the IPv4 forwarding state. It keeps the next hop
+ * node of every network node towards every other node, and re-evaluates only
+ * the entries of the nodes whose routing table has changed, towards the
+ * destinations covered by the changed routes. Forwarding loops
+ * and black holes are detected from the changed entries alone, and the
+ * convergence time and the lifetime of each loop are recorded.
+ *
+ * See the NED file for details.
+ */
+class INET_API Ipv4ForwardingObserver : public cSimpleModule, public cListener
+{
+  protected:
+    enum NextHop {
+        DELIVERED = -1, // the node owns the destination
+        NO_ROUTE = -2, // black hole
+        UNKNOWN = -3, // not yet evaluated
+    };
+
+    struct Node {
+        cModule *module = nullptr;
+        IIpv4RoutingTable *routingTable = nullptr;
+        IInterfaceTable *interfaceTable = nullptr;
+        std::map<int, int> peerByInterfaceId; // point-to-point interface id -> index of the node on the other end
+    };
+
+    struct Loop {
+        simtime_t startTime;
+        std::vector<int> nodes; // in forwarding order, starting with the smallest index
+    };
+
+    typedef std::pair<int, int> LoopKey; // destination index, smallest node index on the cycle
+
+    struct NodeChange {
+        bool allDestinations = false;
+        std::vector<std::pair<Ipv4Address, Ipv4Address>> prefixes; // destination and netmask of the added and deleted routes
+    };
+
+    // configuration
+    cModule *subjectModule = nullptr;
+
+    // state
+    bool topologyExtracted = false;
+    std::vector<Node> nodes;
+    std::map<int, int> nodeIndexByModuleId;
+    std::map<Ipv4Address, int> nodeIndexByAddress;
+    std::vector<Ipv4Address> destinations; // one address of each node, the index is the node index
+    std::vector<std::vector<int>> nextHops; // [node][destination] -> node index or NextHop
+    std::vector<std::vector<unsigned int>> visitMarks; // [destination][node] -> walk that last visited the node
+    unsigned int walkCount = 0;
+    unsigned int batchStartMark = 0; // walkCount before the walks of the current evaluation
+    std::map<int, NodeChange> changedNodes; // module id -> routes changed since the last evaluation
+    std::map<LoopKey, Loop> loops;
+    int blackHoleCount = 0;
+    simtime_t inconsistentSince = -1; // start of the ongoing convergence, -1 if the forwarding state is consistent
+    cMessage *evaluateTimer = nullptr;
+
+    // statistics
+    static simsignal_t convergenceTimeSignal;
+    static simsignal_t loopDurationSignal;
+    static simsignal_t loopCountSignal;
+    static simsignal_t blackHoleCountSignal;
+
+  protected:
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void initialize(int stage) override;
+    virtual void handleMessage(cMessage *msg) override;
+    virtual void refreshDisplay() const override;
+    virtual void preDelete(cComponent *root) override;
+
+    virtual void receiveSignal(cComponent *source, simsignal_t signal, cObject *obj, cObject *details) override;
+
+    virtual void extractTopology();
+    virtual int computeNextHop(int nodeIndex, int destinationIndex) const;
+    virtual bool isAffected(const NodeChange& change, int destinationIndex) const;
+    virtual void evaluateChanges();
+    virtual void walkFrom(int nodeIndex, int destinationIndex, std::vector<int>& path);
+    virtual bool isLoopIntact(int destinationIndex, const Loop& loop) const;
+
+  public:
+    virtual ~Ipv4ForwardingObserver();
+};
+
+} // namespace inet
+
+#endif
@@ -46,6 +46,8 @@ Ipv4RoutingTable::~Ipv4RoutingTable()
 {
     for (auto& elem : routes)
         delete elem;
+    for (auto& elem : pendingDeletedRoutes)
+        delete elem;
     for (auto& elem : multicastRoutes)
         delete elem;
 }
@@ -392,6 +394,7 @@ Ipv4Route *Ipv4RoutingTable::findBestMatchingRoute(const Ipv4Address& dest) cons
 {
     Enter_Method("findBestMatchingRoute(%u.%u.%u.%u)", dest.getDByte(0), dest.getDByte(1), dest.getDByte(2), dest.getDByte(3)); // note: str().c_str() too slow here
 
+    sortRoutesIfDirty();
     auto it = routingCache.find(dest);
     if (it != routingCache.end()) {
         if (it->second == nullptr || it->second->isValid())
@@ -448,6 +451,7 @@ const Ipv4MulticastRoute *Ipv4RoutingTable::findBestMatchingMulticastRoute(const
 
 Ipv4Route *Ipv4RoutingTable::getRoute(int k) const
 {
+    sortRoutesIfDirty();
     if (k < (int)routes.size())
         return routes[k];
     return nullptr;
@@ -456,6 +460,7 @@ Ipv4Route *Ipv4RoutingTable::getRoute(int k) const
 Ipv4Route *Ipv4RoutingTable::getDefaultRoute() const
 {
     // if exists default route entry, it is the last valid entry
+    sortRoutesIfDirty();
     for (RouteVector::const_reverse_iterator i = routes.rbegin(); i != routes.rend() && (*i)->getNetmask().isUnspecified(); ++i) {
         if ((*i)->isValid())
             return *i;
@@ -523,9 +528,16 @@ void Ipv4RoutingTable::internalAddRoute(Ipv4Route *entry)
     // add to tables
     // we keep entries sorted by netmask desc, metric asc in routeList, so that we can
     // stop at the first match when doing the longest netmask matching
-    auto pos = upper_bound(routes.begin(), routes.end(), entry, RouteLessThan(*this));
-    routes.insert(pos, entry);
-    invalidateCache();
+    if (updateDepth > 0) {
+        // sorted into place by commitUpdate() or by the next lookup
+        routes.push_back(entry);
+        routesDirty = true;
+    }
+    else {
+        auto pos = upper_bound(routes.begin(), routes.end(), entry, RouteLessThan(*this));
+        routes.insert(pos, entry);
+        invalidateCache();
+    }
     entry->setRoutingTable(this);
 }
 
@@ -535,7 +547,13 @@ void Ipv4RoutingTable::addRoute(Ipv4Route *entry)
     // This method should be called before calling entry->str()
     internalAddRoute(entry);
 //    EV_INFO << "add route " << entry->str() << "\n";
-    emit(routeAddedSignal, entry);
+    if (updateDepth > 0) {
+        pendingChanges[entry] = PENDING_ADDED;
+        pendingAddedRoutes.push_back(entry);
+        updateChangeCount++;
+    }
+    else
+        emit(routeAddedSignal, entry);
 }
 
 Ipv4Route *Ipv4RoutingTable::internalRemoveRoute(Ipv4Route *entry)
@@ -543,7 +561,10 @@ Ipv4Route *Ipv4RoutingTable::internalRemoveRoute(Ipv4Route *entry)
     auto i = find(routes, entry);
     if (i != routes.end()) {
         routes.erase(i);
-        invalidateCache();
+        if (updateDepth > 0)
+            routesDirty = true;
+        else
+            invalidateCache();
         return entry;
     }
     return nullptr;
@@ -558,7 +579,11 @@ Ipv4Route *Ipv4RoutingTable::removeRoute(Ipv4Route *entry)
     if (entry != nullptr) {
 //        EV_INFO << "remove route " << entry->str() << "\n";
         ASSERT(entry->getRoutingTable() == this); // still filled in, for the listeners' benefit
-        emit(routeDeletedSignal, entry);
+        if (updateDepth > 0)
+            updateChangeCount++;
+        // the caller takes over the route, so the signal cannot be held back
+        if (updateDepth == 0 || !forgetPendingRoute(entry))
+            emit(routeDeletedSignal, entry);
         entry->setRoutingTable(nullptr);
     }
     return entry;
@@ -573,12 +598,98 @@ bool Ipv4RoutingTable::deleteRoute(Ipv4Route *entry) // TODO this is almost dupl
     if (entry != nullptr) {
 //        EV_INFO << "delete route " << entry->str() << "\n";
         ASSERT(entry->getRoutingTable() == this); // still filled in, for the listeners' benefit
-        emit(routeDeletedSignal, entry);
-        delete entry;
+        if (updateDepth == 0) {
+            emit(routeDeletedSignal, entry);
+            delete entry;
+        }
+        else {
+            updateChangeCount++;
+            // a route that was also added in this update has never been announced
+            if (forgetPendingRoute(entry))
+                delete entry;
+            else
+                pendingDeletedRoutes.push_back(entry);
+        }
     }
     return entry != nullptr;
 }
 
+void Ipv4RoutingTable::beginUpdate()
+{
+    Enter_Method("beginUpdate()");
+    updateDepth++;
+}
+
+void Ipv4RoutingTable::commitUpdate()
+{
+    Enter_Method("commitUpdate()");
+    if (updateDepth == 0)
+        throw cRuntimeError("commitUpdate(): no update in progress");
+    if (--updateDepth > 0)
+        return;
+
+    sortRoutesIfDirty();
+
+    // listeners may modify the routing table, so the pending changes are taken over first
+    // (the vectors may also contain routes that were removed in the update, or added again after a removal)
+    RouteVector deletedRoutes, addedRoutes, changedRoutes;
+    deletedRoutes.swap(pendingDeletedRoutes);
+    for (auto route : pendingAddedRoutes) {
+        auto it = pendingChanges.find(route);
+        if (it != pendingChanges.end() && it->second == PENDING_ADDED) {
+            addedRoutes.push_back(route);
+            pendingChanges.erase(it);
+        }
+    }
+    for (auto route : pendingChangedRoutes) {
+        auto it = pendingChanges.find(route);
+        if (it != pendingChanges.end() && it->second == PENDING_CHANGED) {
+            changedRoutes.push_back(route);
+            pendingChanges.erase(it);
+        }
+    }
+    ASSERT(pendingChanges.empty());
+    pendingAddedRoutes.clear();
+    pendingChangedRoutes.clear();
+    int changeCount = updateChangeCount;
+    updateChangeCount = 0;
+
+    for (auto route : deletedRoutes) {
+        ASSERT(route->getRoutingTable() == this); // still filled in, for the listeners' benefit
+        emit(routeDeletedSignal, route);
+        delete route;
+    }
+    for (auto route : addedRoutes)
+        emit(routeAddedSignal, route);
+    for (auto route : changedRoutes)
+        emit(routeChangedSignal, route);
+    if (changeCount > 0)
+        emit(routingTableChangedSignal, changeCount);
+}
+
+void Ipv4RoutingTable::sortRoutesIfDirty() const
+{
+    if (routesDirty) {
+        // stable, so that equal routes keep their insertion order like with upper_bound()
+        std::stable_sort(routes.begin(), routes.end(), RouteLessThan(*this));
+        routingCache.clear();
+        routesDirty = false;
+    }
+}
+
+bool Ipv4RoutingTable::forgetPendingRoute(Ipv4Route *entry)
+{
+    // drops the held back notifications of a route removed inside an update,
+    // and returns true if the route was also added inside the update
+    // (the stale entries of the vectors are skipped by commitUpdate())
+    auto it = pendingChanges.find(entry);
+    if (it == pendingChanges.end())
+        return false;
+    bool added = it->second == PENDING_ADDED;
+    pendingChanges.erase(it);
+    return added;
+}
+
 bool Ipv4RoutingTable::multicastRouteLessThan(const Ipv4MulticastRoute *a, const Ipv4MulticastRoute *b)
 {
     // We want routes with longer
@@ -685,7 +796,13 @@ void Ipv4RoutingTable::routeChanged(Ipv4Route *entry, int fieldCode)
         ASSERT(entry != nullptr); // failure means inconsistency: route was not found in this routing table
         internalAddRoute(entry);
     }
-    emit(routeChangedSignal, entry); // TODO include fieldCode in the notification
+    if (updateDepth > 0) {
+        updateChangeCount++;
+        if (pendingChanges.insert(std::make_pair(entry, PENDING_CHANGED)).second)
+            pendingChangedRoutes.push_back(entry);
+    }
+    else
+        emit(routeChangedSignal, entry); // TODO include fieldCode in the notification
 }
 
 void Ipv4RoutingTable::multicastRouteChanged(Ipv4MulticastRoute *entry, int fieldCode)
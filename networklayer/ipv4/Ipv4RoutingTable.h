@@ -17,6 +17,7 @@
 #ifndef __INET_IPV4ROUTINGTABLE_H
 #define __INET_IPV4ROUTINGTABLE_H
 
+#include <unordered_map>
 #include <vector>
 
 #include "inet/common/ModuleRefByPar.h"
@@ -91,7 +92,17 @@ class INET_API Ipv4RoutingTable : public cSimpleModule, public IIpv4RoutingTable
     // to modify them, but they can not access them directly.
 
     typedef std::vector<Ipv4Route *> RouteVector;
-    RouteVector routes; // Unicast route array, sorted by netmask desc, dest asc, metric asc
+    mutable RouteVector routes; // Unicast route array, sorted by netmask desc, dest asc, metric asc (lazily inside an update)
+
+    // state of the batched update, see beginUpdate()
+    int updateDepth = 0;
+    int updateChangeCount = 0;
+    mutable bool routesDirty = false; // routes may be unsorted and the routing cache stale
+    enum PendingChange { PENDING_ADDED, PENDING_CHANGED };
+    std::unordered_map<const Ipv4Route *, PendingChange> pendingChanges; // held back notification of the added and changed routes
+    RouteVector pendingAddedRoutes; // in the order of the changes, only the ones still in pendingChanges are notified
+    RouteVector pendingChangedRoutes; // ditto
+    RouteVector pendingDeletedRoutes; // already removed from routes, deleted by commitUpdate()
 
     typedef std::vector<Ipv4MulticastRoute *> MulticastRouteVector;
     MulticastRouteVector multicastRoutes; // Multicast route array, sorted by netmask desc, origin asc, metric asc
@@ -131,6 +142,8 @@ class INET_API Ipv4RoutingTable : public cSimpleModule, public IIpv4RoutingTable
     // helper functions:
     void internalAddRoute(Ipv4Route *entry);
     Ipv4Route *internalRemoveRoute(Ipv4Route *entry);
+    void sortRoutesIfDirty() const;
+    bool forgetPendingRoute(Ipv4Route *entry);
     void internalAddMulticastRoute(Ipv4MulticastRoute *entry);
     Ipv4MulticastRoute *internalRemoveMulticastRoute(Ipv4MulticastRoute *entry);
 
@@ -302,6 +315,18 @@ class INET_API Ipv4RoutingTable : public cSimpleModule, public IIpv4RoutingTable
      */
     virtual bool deleteRoute(Ipv4Route *entry) override;
 
+    /**
+     * Starts a batch of unicast route changes, see IIpv4RoutingTable.
+     * Routes removed with removeRoute() inside the batch are notified
+     * immediately, because the caller takes them over.
+     */
+    virtual void beginUpdate() override;
+
+    /**
+     * Applies the batch of unicast route changes, see IIpv4RoutingTable.
+     */
+    virtual void commitUpdate() override;
+
     /**
      * Returns the total number of multicast routes.
      */
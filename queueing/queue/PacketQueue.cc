@@ -24,6 +24,7 @@
 #include "inet/networklayer/contract/ipv4/Ipv4Address.h"
 #include "inet/networklayer/common/NetworkInterface.h"
 #include "inet/routing/ospfv2/router/Ospfv2Common.h"
+#include "inet/routing/ospfv2/router/Ospfv2ResultFiles.h"
 #include "inet/networklayer/ipv4/Ipv4.h"
 #include <cmath>
 
@@ -38,17 +39,9 @@ Define_Module(PacketQueue);
 PacketQueue::~PacketQueue()
 {
     delete packetDropperFunction;
+    cancelAndDelete(fluidServedTimer);
 }
 
-void PacketQueue::finish()
-{
-    if (ofs.is_open()) {
-        ofs.close();
-    }
-}
-
-std::ofstream PacketQueue::ofs;
-
 void PacketQueue::initialize(int stage)
 {
     PacketQueueBase::initialize(stage);
@@ -63,6 +56,11 @@ void PacketQueue::initialize(int stage)
         if (packetComparatorFunction != nullptr)
             queue.setup(packetComparatorFunction);
         packetDropperFunction = createDropperFunction(par("dropperClass"));
+        leanDataPath = par("leanDataPath");
+        ospfModule.reference(this, "ospfModule", false);
+        fluidServedTimer = new cMessage("fluidServed");
+        WATCH(fluidBacklog);
+        WATCH(fluidDroppedLength);
     }
     else if (stage == INITSTAGE_QUEUEING) {
         checkPacketOperationSupport(inputGate);
@@ -72,24 +70,6 @@ void PacketQueue::initialize(int stage)
     }
     else if (stage == INITSTAGE_LAST)
         updateDisplayString();
-
-    /*
-     * @sqsq
-     */
-    if (!ofs.is_open()) {
-        std::string filename = "/home/sqsq/Desktop/"
-                "sat-ospf/inet/examples/ospfv2/sqsqtest/results/";
-        filename += EXPERIMENT_NAME;
-        filename += "/";
-
-        filename += IS_OSPF ? "OSPF" : std::to_string(SQSQ_HOP);
-
-        filename += "/";
-        filename += getEnvir()->getConfigEx()->getActiveConfigName();
-        filename += "/queueDropPacketRaw.csv";
-        ofs.open(filename, std::ios::app | std::ios::out);
-//        std::cout << "filename: " << filename << "  " << ofs.is_open() << endl;
-    }
 }
 
 IPacketDropperFunction *PacketQueue::createDropperFunction(const char *dropperClass) const
@@ -108,10 +88,28 @@ IPacketComparatorFunction *PacketQueue::createComparatorFunction(const char *com
         return check_and_cast<IPacketComparatorFunction *>(createOne(comparatorClass));
 }
 
+void PacketQueue::handleMessage(cMessage *message)
+{
+    if (message == fluidServedTimer) {
+        updateFluidBacklog();
+        if (canPullSomePacket(outputGate)) {
+            if (collector != nullptr)
+                collector->handleCanPullPacketChanged(outputGate->getPathEndGate());
+        }
+        else
+            scheduleFluidServedTimer();
+    }
+    else
+        PacketQueueBase::handleMessage(message);
+}
+
 bool PacketQueue::isOverloaded() const
 {
-    return (packetCapacity != -1 && getNumPackets() > packetCapacity) ||
-           (dataCapacity != b(-1) && getTotalLength() > dataCapacity);
+    if ((packetCapacity != -1 && getNumPackets() > packetCapacity) ||
+        (dataCapacity != b(-1) && getTotalLength() > dataCapacity))
+        return true;
+    // the fluid takes the buffer space left by the packets, one bit is allowed for rounding errors
+    return fluidBacklog > getFluidCapacity(getNumPackets(), getTotalLength()) + 1;
 }
 
 int PacketQueue::getNumPackets() const
@@ -134,7 +132,9 @@ void PacketQueue::pushPacket(Packet *packet, cGate *gate)
     cNamedObject packetPushStartedDetails("atomicOperationStarted");
     emit(packetPushStartedSignal, packet, &packetPushStartedDetails);
     EV_INFO << "Pushing packet" << EV_FIELD(packet) << EV_ENDL;
+    updateFluidBacklog();
     queue.insert(packet);
+    addFluidAheadMark(packet);
 
     /*
      * @sqsq
@@ -153,35 +153,28 @@ void PacketQueue::pushPacket(Packet *packet, cGate *gate)
              * @sqsq
              */
 //            std::cout << "at: " << simTime() << " " << this->getParentModule()->getFullPath() << " drop packet" << std::endl;
-            if (ofs.is_open() && RECORD_CSV) {
-                ofs << getEnvir()->getConfigEx()->getActiveConfigName() << ",";
-                ofs << SQSQ_HOP << ",";
-                ofs << this->getParentModule()->getFullPath() << ",";
-                ofs << simTime() << ",";
-                ofs << 0 << ",";
-                ofs << 0 << ",";
-                ofs << 0 << ",";
-                ofs << 1;
-                ofs << std::endl;
-//                ofs.flush();
-            }
+            recordDroppedPacket();
 
             EV_INFO << "Dropping packet" << EV_FIELD(packet) << EV_ENDL;
             queue.remove(packet);
+            removeFluidAheadMark(packet);
             dropPacket(packet, QUEUE_OVERFLOW);
         }
     }
     ASSERT(!isOverloaded());
+    scheduleFluidServedTimer();
     if (collector != nullptr && getNumPackets() != 0)
         collector->handleCanPullPacketChanged(outputGate->getPathEndGate());
     cNamedObject packetPushEndedDetails("atomicOperationEnded");
     emit(packetPushEndedSignal, nullptr, &packetPushEndedDetails);
-    updateDisplayString();
+    if (!leanDataPath)
+        updateDisplayString();
 }
 
 Packet *PacketQueue::pullPacket(cGate *gate)
 {
     Enter_Method("pullPacket");
+    updateFluidBacklog();
     auto packet = check_and_cast<Packet *>(queue.front());
 
     EV_INFO << "Pulling packet" << EV_FIELD(packet) << EV_ENDL;
@@ -191,6 +184,8 @@ Packet *PacketQueue::pullPacket(cGate *gate)
     }
     else
         queue.pop();
+    removeFluidAheadMark(packet);
+    scheduleFluidServedTimer();
 
     /*
      * @sqsq
@@ -198,15 +193,19 @@ Packet *PacketQueue::pullPacket(cGate *gate)
     checkAndEmitQueueLoadLevel(packet);
     O++;
 
-    auto queueingTime = simTime() - packet->getArrivalTime();
-    auto packetEvent = new PacketQueuedEvent();
-    packetEvent->setQueuePacketLength(getNumPackets());
-    packetEvent->setQueueDataLength(getTotalLength());
-    insertPacketEvent(this, packet, PEK_QUEUED, queueingTime, packetEvent);
-    increaseTimeTag<QueueingTimeTag>(packet, queueingTime, queueingTime);
+    if (!leanDataPath) {
+        auto queueingTime = simTime() - packet->getArrivalTime();
+        auto packetEvent = new PacketQueuedEvent();
+        packetEvent->setQueuePacketLength(getNumPackets());
+        packetEvent->setQueueDataLength(getTotalLength());
+        insertPacketEvent(this, packet, PEK_QUEUED, queueingTime, packetEvent);
+        increaseTimeTag<QueueingTimeTag>(packet, queueingTime, queueingTime);
+    }
     emit(packetPulledSignal, packet);
-    animatePullPacket(packet, outputGate);
-    updateDisplayString();
+    if (!leanDataPath) {
+        animatePullPacket(packet, outputGate);
+        updateDisplayString();
+    }
     return packet;
 }
 
@@ -214,7 +213,10 @@ void PacketQueue::removePacket(Packet *packet)
 {
     Enter_Method("removePacket");
     EV_INFO << "Removing packet" << EV_FIELD(packet) << EV_ENDL;
+    updateFluidBacklog();
     queue.remove(packet);
+    removeFluidAheadMark(packet);
+    scheduleFluidServedTimer();
     if (buffer != nullptr)
         buffer->removePacket(packet);
     emit(packetRemovedSignal, packet);
@@ -228,6 +230,7 @@ void PacketQueue::removeAllPackets()
     std::vector<Packet *> packets;
     for (int i = 0; i < getNumPackets(); i++)
         packets.push_back(check_and_cast<Packet *>(queue.pop()));
+    removeAllFluidAheadMarks();
     if (buffer != nullptr)
         buffer->removeAllPackets();
     for (auto packet : packets) {
@@ -245,6 +248,8 @@ bool PacketQueue::canPushSomePacket(cGate *gate) const
         return false;
     if (getMaxTotalLength() != b(-1) && getTotalLength() >= getMaxTotalLength())
         return false;
+    if (fluidBacklog > getFluidCapacity(getNumPackets() + 1, getTotalLength()) + 1)
+        return false;
     return true;
 }
 
@@ -256,6 +261,8 @@ bool PacketQueue::canPushPacket(Packet *packet, cGate *gate) const
         return false;
     if (getMaxTotalLength() != b(-1) && getMaxTotalLength() - getTotalLength() < packet->getDataLength())
         return false;
+    if (fluidBacklog > getFluidCapacity(getNumPackets() + 1, getTotalLength() + packet->getDataLength()) + 1)
+        return false;
     return true;
 }
 
@@ -264,12 +271,35 @@ void PacketQueue::handlePacketRemoved(Packet *packet)
     Enter_Method("handlePacketRemoved");
     if (queue.contains(packet)) {
         EV_INFO << "Removing packet" << EV_FIELD(packet) << EV_ENDL;
+        updateFluidBacklog();
         queue.remove(packet);
+        removeFluidAheadMark(packet);
+        scheduleFluidServedTimer();
         emit(packetRemovedSignal, packet);
         updateDisplayString();
     }
 }
 
+/*
+ * @sqsq
+ */
+void PacketQueue::recordDroppedPacket()
+{
+    if (RECORD_CSV) {
+        std::ostream& ofs = ospfv2::Ospfv2ResultFiles::getFile("queueDropPacketRaw.csv");
+        ofs << getEnvir()->getConfigEx()->getActiveConfigName() << ",";
+        ofs << SQSQ_HOP << ",";
+        ofs << this->getParentModule()->getFullPath() << ",";
+        ofs << simTime() << ",";
+        ofs << 0 << ",";
+        ofs << 0 << ",";
+        ofs << 0 << ",";
+        ofs << 1;
+        ofs << std::endl;
+//        ofs.flush();
+    }
+}
+
 /*
  * @sqsq
  * when number of packets changes exceed a threshold (i.e. capacity / 5)
@@ -277,8 +307,10 @@ void PacketQueue::handlePacketRemoved(Packet *packet)
  */
 void PacketQueue::checkAndEmitQueueLoadLevel(Packet *packet)
 {
-    int currentNumPackets = getNumPackets();
-    inet::ospfv2::Ospfv2 *ospfModule = check_and_cast<inet::ospfv2::Ospfv2 *>(this->getParentModule()->getParentModule()->getSubmodule("ospf"));
+    if (ospfModule == nullptr)
+        return; // not in a satellite node
+    updateFluidBacklog();
+    int currentNumPackets = std::lround(getOccupiedNumPackets());
     ospfv2::Router *ospfRouter = ospfModule->getOspfRouter();
     ospfv2::Ospfv2Area *ospfArea = ospfRouter->getAreaByID(Ipv4Address(0, 0, 0, 0));
     Ipv4Address routerID = ospfRouter->getRouterID();
@@ -325,8 +357,8 @@ void PacketQueue::checkAndEmitQueueLoadLevel(Packet *packet)
  */
 void PacketQueue::calculateAndChangeOSPFChi()
 {
-    int currentNumPackets = getNumPackets();
-    inet::ospfv2::Ospfv2 *ospfModule = check_and_cast<inet::ospfv2::Ospfv2 *>(this->getParentModule()->getParentModule()->getSubmodule("ospf"));
+    updateFluidBacklog();
+    double currentNumPackets = getOccupiedNumPackets();
     ospfv2::Router *ospfRouter = ospfModule->getOspfRouter();
     ospfv2::Ospfv2Area *ospfArea = ospfRouter->getAreaByID(Ipv4Address(0, 0, 0, 0));
     Ipv4Address routerID = ospfRouter->getRouterID();
@@ -357,8 +389,8 @@ void PacketQueue::calculateAndChangeOSPFChi()
 
     double delta = ospfModule->getDelta();
     if (I - O != 0) {
-        double elapsingTime = (double)(getMaxNumPackets() - getNumPackets())
-                / (double)(I - O);
+        double elapsingTime = ((double)getMaxNumPackets() - currentNumPackets)
+                / (I - O);
         double p = std::min(1.0, (delta + maxPropagationDelay) / elapsingTime);
         double beta = 1.0 - p, alpha = beta / 2;
         double qtBSA = std::min(
@@ -367,7 +399,7 @@ void PacketQueue::calculateAndChangeOSPFChi()
         double theta = 10 * totalPropagationDelay;
         double INew = (qtBSA - getMaxNumPackets() * alpha) / theta + O;
         double chi;
-        if ((double)getNumPackets() >= (double)getMaxNumPackets() * beta) {
+        if (currentNumPackets >= (double)getMaxNumPackets() * beta) {
             chi = std::min(std::max(0.0, INew / I), 1.0);
         }
         else {
@@ -386,6 +418,124 @@ void PacketQueue::calculateAndChangeOSPFChi()
     I = 0;
     O = 0;
 }
+
+/*
+ * @sqsq
+ */
+void PacketQueue::setFluidRates(double arrivalRate, double serviceRate)
+{
+    Enter_Method("setFluidRates");
+    // the backlog is integrated with the old rates up to now
+    updateFluidBacklog();
+    fluidArrivalRate = arrivalRate;
+    fluidServiceRate = serviceRate;
+    scheduleFluidServedTimer();
+    checkAndEmitQueueLoadLevel(nullptr);
+}
+
+void PacketQueue::updateFluidBacklog()
+{
+    simtime_t now = simTime();
+    double interval = (now - fluidUpdateTime).dbl();
+    fluidUpdateTime = now;
+    if (interval <= 0 || (fluidArrivalRate == 0 && fluidBacklog == 0))
+        return;
+    double backlog;
+    double droppedLength;
+    double servedLength = integrateFluidBacklog(interval, backlog, droppedLength);
+    double packetLength = ospfv2::averagePacketSize * 8;
+    I += fluidArrivalRate * interval / packetLength;
+    O += servedLength / packetLength;
+    fluidDroppedLength += droppedLength;
+    fluidServedLength += servedLength;
+    fluidBacklog = backlog;
+}
+
+double PacketQueue::integrateFluidBacklog(double interval, double& backlog, double& droppedLength) const
+{
+    // the rates are constant between the updates, so the solution is linear until the backlog hits a bound
+    double arrivedLength = fluidArrivalRate * interval;
+    double capacity = getFluidCapacity(getNumPackets(), getTotalLength());
+    backlog = fluidBacklog + arrivedLength - fluidServiceRate * interval;
+    droppedLength = 0;
+    if (backlog < 0)
+        backlog = 0;
+    else if (backlog > capacity) {
+        droppedLength = backlog - capacity;
+        backlog = capacity;
+    }
+    return fluidBacklog + arrivedLength - droppedLength - backlog;
+}
+
+double PacketQueue::getFluidCapacity(int numPackets, b totalLength) const
+{
+    // the buffer space left by the given packets, a packet takes averagePacketSize of the packet capacity
+    double capacity = INFINITY;
+    if (packetCapacity != -1)
+        capacity = (double)(packetCapacity - numPackets) * ospfv2::averagePacketSize * 8;
+    if (dataCapacity != b(-1))
+        capacity = std::min(capacity, (double)(dataCapacity - totalLength).get());
+    return std::max(capacity, 0.0);
+}
+
+double PacketQueue::getFluidDeliveryRatio() const
+{
+    // a full queue forwards at the service rate and drops the rest
+    if (fluidArrivalRate > fluidServiceRate && fluidBacklog >= getFluidCapacity(getNumPackets(), getTotalLength()))
+        return fluidServiceRate / fluidArrivalRate;
+    return 1;
+}
+
+bool PacketQueue::isFluidAheadServed(const Packet *packet) const
+{
+    auto it = fluidServedLengthMarks.find(packet);
+    if (it == fluidServedLengthMarks.end())
+        return true;
+    double servedLength = fluidServedLength;
+    double interval = (simTime() - fluidUpdateTime).dbl();
+    if (interval > 0) {
+        double backlog;
+        double droppedLength;
+        servedLength += integrateFluidBacklog(interval, backlog, droppedLength);
+    }
+    // one bit is allowed for rounding errors
+    return servedLength + 1 >= it->second;
+}
+
+void PacketQueue::scheduleFluidServedTimer()
+{
+    // the fluid ahead of the first packet is served at the service rate, as the backlog is not empty until then
+    auto it = !isEmpty() ? fluidServedLengthMarks.find(getPacket(0)) : fluidServedLengthMarks.end();
+    if (it == fluidServedLengthMarks.end() || fluidServiceRate <= 0 || isFluidAheadServed(it->first))
+        cancelEvent(fluidServedTimer);
+    else {
+        updateFluidBacklog();
+        rescheduleAfter(std::max(0.0, it->second - fluidServedLength) / fluidServiceRate, fluidServedTimer);
+    }
+}
+
+void PacketQueue::addFluidAheadMark(const Packet *packet)
+{
+    // the packet can only be pulled after the fluid queued before it has been served
+    if (fluidBacklog > 0)
+        fluidServedLengthMarks[packet] = fluidServedLength + fluidBacklog;
+}
+
+void PacketQueue::removeFluidAheadMark(const Packet *packet)
+{
+    fluidServedLengthMarks.erase(packet);
+}
+
+void PacketQueue::removeAllFluidAheadMarks()
+{
+    fluidServedLengthMarks.clear();
+    cancelEvent(fluidServedTimer);
+}
+
+double PacketQueue::getOccupiedNumPackets() const
+{
+    return getNumPackets() + fluidBacklog / (ospfv2::averagePacketSize * 8);
+}
 } // namespace queueing
 } // namespace inet
 
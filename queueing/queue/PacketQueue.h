@@ -8,6 +8,8 @@
 #ifndef __INET_PACKETQUEUE_H
 #define __INET_PACKETQUEUE_H
 
+#include <map>
+
 #include "inet/queueing/base/PacketQueueBase.h"
 #include "inet/queueing/contract/IActivePacketSink.h"
 #include "inet/queueing/contract/IActivePacketSource.h"
@@ -18,8 +20,9 @@
 /*
  * @sqsq
  */
+#include "inet/common/ModuleRefByPar.h"
 #include "inet/networklayer/ipv4/Ipv4.h"
-#include <fstream>
+#include "inet/routing/ospfv2/Ospfv2.h"
 
 namespace inet {
 namespace queueing {
@@ -87,22 +90,40 @@ class INET_API PacketQueue : public PacketQueueBase, public IPacketBuffer::ICall
     IPacketDropperFunction *packetDropperFunction = nullptr;
     IPacketComparatorFunction *packetComparatorFunction = nullptr;
 
+    bool leanDataPath = false;
+
     /*
      * @sqsq
      */
+    ModuleRefByPar<ospfv2::Ospfv2> ospfModule; // the Ospfv2 module of the node, it receives the queue load signals and the ELB chi values
     int previousNumPackets = 0;
-    static std::ofstream ofs;
-    int I = 0; //ELB: monitor queue in every delta interal time
-    int O = 0;
+    double I = 0; //ELB: monitor queue in every delta interal time (fluid traffic counts fractional packets)
+    double O = 0;
+
+    // fluid background traffic, set by FluidBackgroundTraffic
+    double fluidArrivalRate = 0; // [bps]
+    double fluidServiceRate = 0; // [bps]
+    double fluidBacklog = 0; // [b]
+    double fluidDroppedLength = 0; // [b], total
+    double fluidServedLength = 0; // [b], total
+    simtime_t fluidUpdateTime;
+    std::map<const Packet *, double> fluidServedLengthMarks; // packet -> fluidServedLength when the fluid queued ahead of it has been served
+    cMessage *fluidServedTimer = nullptr; // fires when the fluid ahead of the first packet has been served
 
   protected:
     virtual void initialize(int stage) override;
+    virtual void handleMessage(cMessage *message) override;
 
     virtual IPacketDropperFunction *createDropperFunction(const char *dropperClass) const;
     virtual IPacketComparatorFunction *createComparatorFunction(const char *comparatorClass) const;
 
     virtual bool isOverloaded() const;
 
+    /*
+     * @sqsq
+     */
+    virtual void recordDroppedPacket();
+
   public:
     virtual ~PacketQueue(); /*{ delete packetDropperFunction; }*/
 
@@ -123,8 +144,8 @@ class INET_API PacketQueue : public PacketQueueBase, public IPacketBuffer::ICall
     virtual void pushPacket(Packet *packet, cGate *gate) override;
 
     virtual bool supportsPacketPulling(cGate *gate) const override { return outputGate == gate; }
-    virtual bool canPullSomePacket(cGate *gate) const override { return !isEmpty(); }
-    virtual Packet *canPullPacket(cGate *gate) const override { return !isEmpty() ? getPacket(0) : nullptr; }
+    virtual bool canPullSomePacket(cGate *gate) const override { return !isEmpty() && isFluidAheadServed(getPacket(0)); }
+    virtual Packet *canPullPacket(cGate *gate) const override { return canPullSomePacket(gate) ? getPacket(0) : nullptr; }
     virtual Packet *pullPacket(cGate *gate) override;
 
     virtual void handlePacketRemoved(Packet *packet) override;
@@ -133,8 +154,35 @@ class INET_API PacketQueue : public PacketQueueBase, public IPacketBuffer::ICall
      * @sqsq
      */
     virtual void checkAndEmitQueueLoadLevel(Packet *packet);
-    virtual void finish() override;
     virtual void calculateAndChangeOSPFChi();
+
+    /*
+     * @sqsq
+     * Fluid background traffic: the backlog follows dq/dt = arrival rate - service rate
+     * between the rate updates, limited by the buffer space left by the packets. It
+     * shares the load signals and the ELB counters with the packets, it counts into the
+     * overload of the queue, and a packet can only be pulled after the fluid that was
+     * queued ahead of it has been served.
+     */
+    virtual void setFluidRates(double arrivalRate, double serviceRate);
+    virtual void updateFluidBacklog();
+    virtual double integrateFluidBacklog(double interval, double& backlog, double& droppedLength) const;
+    virtual double getFluidCapacity(int numPackets, b totalLength) const;
+    virtual bool isFluidAheadServed(const Packet *packet) const;
+    virtual void scheduleFluidServedTimer();
+    virtual double getFluidDeliveryRatio() const;
+    virtual double getOccupiedNumPackets() const;
+
+  protected:
+    /*
+     * @sqsq
+     * The fluid bookkeeping of the packets, for the subclasses that store the
+     * packets themselves: updateFluidBacklog() must be called before a packet is
+     * inserted or removed, and scheduleFluidServedTimer() afterwards.
+     */
+    virtual void addFluidAheadMark(const Packet *packet);
+    virtual void removeFluidAheadMark(const Packet *packet);
+    virtual void removeAllFluidAheadMarks();
 };
 
 } // namespace queueing
@@ -0,0 +1,196 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+
+#include "inet/queueing/queue/RingBufferPacketQueue.h"
+
+#include "inet/common/PacketEventTag.h"
+#include "inet/common/Simsignals.h"
+#include "inet/common/TimeTag.h"
+
+namespace inet {
+namespace queueing {
+
+Define_Module(RingBufferPacketQueue);
+
+RingBufferPacketQueue::~RingBufferPacketQueue()
+{
+    for (int i = 0; i < numPackets; i++)
+        delete ring[getRingIndex(i)];
+}
+
+void RingBufferPacketQueue::initialize(int stage)
+{
+    PacketQueue::initialize(stage);
+    if (stage == INITSTAGE_LOCAL) {
+        if (buffer != nullptr)
+            throw cRuntimeError("The bufferModule parameter is not supported");
+        if (packetComparatorFunction != nullptr)
+            throw cRuntimeError("The comparatorClass parameter is not supported, the queue is always FIFO");
+        const char *dropperClass = par("dropperClass");
+        if (!strcmp(dropperClass, "inet::queueing::PacketAtCollectionEndDropper"))
+            dropTail = true;
+        else if (strlen(dropperClass) != 0)
+            throw cRuntimeError("Unsupported dropperClass '%s', the queue can only drop at the tail", dropperClass);
+        // with a packet capacity the ring never has to grow
+        size_t ringSize = 16;
+        while (packetCapacity != -1 && ringSize < (size_t)packetCapacity + 1)
+            ringSize *= 2;
+        ring.resize(ringSize, nullptr);
+        WATCH(numPackets);
+        WATCH(totalLength);
+    }
+}
+
+void RingBufferPacketQueue::growRing()
+{
+    std::vector<Packet *> newRing(ring.size() * 2, nullptr);
+    for (int i = 0; i < numPackets; i++)
+        newRing[i] = ring[getRingIndex(i)];
+    ring.swap(newRing);
+    head = 0;
+}
+
+void RingBufferPacketQueue::removePacketAt(int index)
+{
+    Packet *packet = ring[getRingIndex(index)];
+    if (index == 0) {
+        ring[head] = nullptr;
+        head = getRingIndex(1);
+    }
+    else {
+        for (int i = index; i < numPackets - 1; i++)
+            ring[getRingIndex(i)] = ring[getRingIndex(i + 1)];
+        ring[getRingIndex(numPackets - 1)] = nullptr;
+    }
+    numPackets--;
+    totalLength -= packet->getTotalLength();
+}
+
+Packet *RingBufferPacketQueue::getPacket(int index) const
+{
+    if (index < 0 || index >= numPackets)
+        throw cRuntimeError("index %i out of range", index);
+    return ring[getRingIndex(index)];
+}
+
+void RingBufferPacketQueue::pushPacket(Packet *packet, cGate *gate)
+{
+    Enter_Method("pushPacket");
+
+    take(packet);
+    cNamedObject packetPushStartedDetails("atomicOperationStarted");
+    emit(packetPushStartedSignal, packet, &packetPushStartedDetails);
+    EV_INFO << "Pushing packet" << EV_FIELD(packet) << EV_ENDL;
+    updateFluidBacklog();
+    if (numPackets == (int)ring.size())
+        growRing();
+    ring[getRingIndex(numPackets)] = packet;
+    numPackets++;
+    totalLength += packet->getTotalLength();
+    addFluidAheadMark(packet);
+
+    /*
+     * @sqsq
+     */
+    checkAndEmitQueueLoadLevel(packet);
+    I++;
+
+    // also the fluid backlog can overload the queue
+    while (isOverloaded()) {
+        if (!dropTail)
+            throw cRuntimeError("The queue is overloaded, but no dropperClass is configured");
+        auto droppedPacket = ring[getRingIndex(numPackets - 1)];
+        recordDroppedPacket();
+        EV_INFO << "Dropping packet" << EV_FIELD(droppedPacket) << EV_ENDL;
+        removePacketAt(numPackets - 1);
+        removeFluidAheadMark(droppedPacket);
+        dropPacket(droppedPacket, QUEUE_OVERFLOW);
+    }
+    scheduleFluidServedTimer();
+    if (collector != nullptr && numPackets != 0)
+        collector->handleCanPullPacketChanged(outputGate->getPathEndGate());
+    cNamedObject packetPushEndedDetails("atomicOperationEnded");
+    emit(packetPushEndedSignal, nullptr, &packetPushEndedDetails);
+    if (!leanDataPath)
+        updateDisplayString();
+}
+
+Packet *RingBufferPacketQueue::pullPacket(cGate *gate)
+{
+    Enter_Method("pullPacket");
+    if (numPackets == 0)
+        throw cRuntimeError("Cannot pull packet from an empty queue");
+    updateFluidBacklog();
+    auto packet = ring[head];
+    EV_INFO << "Pulling packet" << EV_FIELD(packet) << EV_ENDL;
+    removePacketAt(0);
+    removeFluidAheadMark(packet);
+    scheduleFluidServedTimer();
+    drop(packet);
+
+    /*
+     * @sqsq
+     */
+    checkAndEmitQueueLoadLevel(packet);
+    O++;
+
+    if (!leanDataPath) {
+        auto queueingTime = simTime() - packet->getArrivalTime();
+        auto packetEvent = new PacketQueuedEvent();
+        packetEvent->setQueuePacketLength(numPackets);
+        packetEvent->setQueueDataLength(totalLength);
+        insertPacketEvent(this, packet, PEK_QUEUED, queueingTime, packetEvent);
+        increaseTimeTag<QueueingTimeTag>(packet, queueingTime, queueingTime);
+    }
+    emit(packetPulledSignal, packet);
+    if (!leanDataPath) {
+        animatePullPacket(packet, outputGate);
+        updateDisplayString();
+    }
+    return packet;
+}
+
+void RingBufferPacketQueue::removePacket(Packet *packet)
+{
+    Enter_Method("removePacket");
+    EV_INFO << "Removing packet" << EV_FIELD(packet) << EV_ENDL;
+    for (int i = 0; i < numPackets; i++) {
+        if (ring[getRingIndex(i)] == packet) {
+            updateFluidBacklog();
+            removePacketAt(i);
+            removeFluidAheadMark(packet);
+            scheduleFluidServedTimer();
+            drop(packet);
+            emit(packetRemovedSignal, packet);
+            updateDisplayString();
+            return;
+        }
+    }
+    throw cRuntimeError("Packet %s is not in the queue", packet->getName());
+}
+
+void RingBufferPacketQueue::removeAllPackets()
+{
+    Enter_Method("removeAllPackets");
+    EV_INFO << "Removing all packets" << EV_ENDL;
+    updateFluidBacklog();
+    removeAllFluidAheadMarks();
+    while (numPackets != 0) {
+        auto packet = ring[head];
+        removePacketAt(0);
+        emit(packetRemovedSignal, packet);
+        delete packet;
+    }
+    updateDisplayString();
+}
+
+void RingBufferPacketQueue::handlePacketRemoved(Packet *packet)
+{
+    // there is no shared packet buffer
+}
+
+} // namespace queueing
+} // namespace inet
+
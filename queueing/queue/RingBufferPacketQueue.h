@@ -0,0 +1,55 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+
+#ifndef __INET_RINGBUFFERPACKETQUEUE_H
+#define __INET_RINGBUFFERPACKETQUEUE_H
+
+#include "inet/queueing/queue/PacketQueue.h"
+
+namespace inet {
+namespace queueing {
+
+/**
+ * FIFO drop tail packet queue storing the packets in a circular array, see
+ * the NED file for details.
+ */
+class INET_API RingBufferPacketQueue : public PacketQueue
+{
+  protected:
+    bool dropTail = false;
+
+    std::vector<Packet *> ring; // the capacity is always a power of two
+    int head = 0; // index of the first packet in the ring
+    int numPackets = 0;
+    b totalLength = b(0);
+
+  protected:
+    virtual void initialize(int stage) override;
+
+    int getRingIndex(int index) const { return (head + index) & (ring.size() - 1); }
+    virtual void growRing();
+    virtual void removePacketAt(int index);
+
+  public:
+    virtual ~RingBufferPacketQueue();
+
+    virtual int getNumPackets() const override { return numPackets; }
+    virtual b getTotalLength() const override { return totalLength; }
+
+    virtual Packet *getPacket(int index) const override;
+    virtual void removePacket(Packet *packet) override;
+    virtual void removeAllPackets() override;
+
+    virtual void pushPacket(Packet *packet, cGate *gate) override;
+    virtual Packet *pullPacket(cGate *gate) override;
+
+    virtual void handlePacketRemoved(Packet *packet) override;
+};
+
+} // namespace queueing
+} // namespace inet
+
+#endif
+
@@ -17,7 +17,9 @@
 #include "inet/common/ModuleAccess.h"
 #include "inet/common/lifecycle/ModuleOperations.h"
 #include "inet/common/lifecycle/NodeStatus.h"
+#include "inet/routing/ospfv2/Ospfv2AnalyticBootstrap.h"
 #include "inet/routing/ospfv2/Ospfv2ConfigReader.h"
+#include "inet/routing/ospfv2/Ospfv2Snapshot.h"
 #include "inet/routing/ospfv2/messagehandler/MessageHandler.h"
 
 /*
@@ -51,6 +53,7 @@ Ospfv2::Ospfv2()
 Ospfv2::~Ospfv2()
 {
     cancelAndDelete(startupTimer);
+    cancelAndDelete(snapshotTimer);
     delete ospfRouter;
 
     /*
@@ -71,10 +74,21 @@ void Ospfv2::initialize(int stage)
         ift.reference(this, "interfaceTableModule", true);
         rt.reference(this, "routingTableModule", true);
         startupTimer = new cMessage("OSPF-startup");
+        snapshotTimer = new cMessage("OSPF-snapshot");
     }
     else if (stage == INITSTAGE_ROUTING_PROTOCOLS) { // interfaces and static routes are already initialized
         registerProtocol(Protocol::ospf, gate("ipOut"), gate("ipIn"));
 
+        if (par("analyticBootstrap")) {
+            if (ospfRouter == nullptr)
+                throw cRuntimeError("Analytic bootstrap requires startupTime = 0 and the node to be up at initialization");
+            if (par("restoreSnapshot"))
+                throw cRuntimeError("Analytic bootstrap and restoreSnapshot cannot be used together");
+            if (getEnvir()->getParsimNumPartitions() > 1)
+                throw cRuntimeError("Analytic bootstrap needs all routers in one process, use restoreSnapshot with parallel simulation");
+            Ospfv2AnalyticBootstrap::addRouter(host, ospfRouter);
+        }
+
         /*
          * @sqsq
          */
@@ -82,14 +96,33 @@ void Ospfv2::initialize(int stage)
             ospfRouter->getMessageHandler()->startTimer(ELBTimer, delta);
         }
     }
+    else if (stage == INITSTAGE_LAST) {
+        // all routers have been registered in INITSTAGE_ROUTING_PROTOCOLS
+        if (par("analyticBootstrap"))
+            Ospfv2AnalyticBootstrap::bootstrap();
+    }
 }
 
 void Ospfv2::handleMessageWhenUp(cMessage *msg)
 {
+    // a routing table calculated in the background must be in place before the router does anything else
+    if (ospfRouter != nullptr)
+        ospfRouter->finishRoutingTableRebuild();
+
     if (msg == startupTimer) {
         createOspfRouter();
         subscribe();
     }
+    else if (msg == snapshotTimer) {
+        if (ospfRouter == nullptr)
+            throw cRuntimeError("Cannot save OSPF snapshot before OSPF has started");
+        Ospfv2Snapshot::save(par("snapshotFile"), host->getFullPath().c_str(), ospfRouter);
+    }
+    else if (msg == ospfRouter->getSpfCommitTimer()) {
+        // the routing table has been installed above
+    }
+    else if (msg == ospfRouter->getFastRerouteHoldTimer())
+        ospfRouter->finishFastReroute();
     else
         ospfRouter->getMessageHandler()->messageReceived(msg);
 
@@ -106,6 +139,14 @@ void Ospfv2::createOspfRouter()
         throw cRuntimeError("Error reading AS configuration from %s", ospfConfig->getSourceLocation());
 
     ospfRouter->addWatches();
+
+    int spfThreads = par("spfThreads");
+    if (spfThreads > 0)
+        ospfRouter->setSpfWorkerPool(Ospfv2SpfWorkerPool::getInstance(spfThreads));
+    ospfRouter->setFastReroute(par("fastReroute"), par("fastRerouteSpfDelay"));
+
+    if (par("restoreSnapshot"))
+        Ospfv2Snapshot::restore(par("snapshotFile"), host->getFullPath().c_str(), ospfRouter);
 }
 
 void Ospfv2::subscribe()
@@ -143,6 +184,9 @@ void Ospfv2::receiveSignal(cComponent *source, simsignal_t signalID, cObject *ob
 {
     Enter_Method("%s", cComponent::getSignalName(signalID));
 
+    if (ospfRouter != nullptr)
+        ospfRouter->finishRoutingTableRebuild();
+
     const NetworkInterface *ie;
     const NetworkInterfaceChangeDetails *change;
 
@@ -252,7 +296,7 @@ void Ospfv2::receiveSignal(cComponent *source, simsignal_t signalID, cObject *ob
                         else {
                             RouterLsa *newLSA = foundIntf->getArea()->originateRouterLSA();
 
-                            newLSA->getHeaderForUpdate().setLsSequenceNumber(sequenceNumber + 1);
+                            setLsaSequenceNumber(*newLSA, sequenceNumber + 1);
                             shouldRebuildRoutingTable |= routerLSA->update(newLSA);
                             delete newLSA;
 
@@ -272,7 +316,7 @@ void Ospfv2::receiveSignal(cComponent *source, simsignal_t signalID, cObject *ob
                     }
 
                     if (shouldRebuildRoutingTable) {
-                        ospfRouter->rebuildRoutingTable();
+                        ospfRouter->requestRoutingTableRebuild();
                     }
 
                     break;
@@ -306,6 +350,9 @@ void Ospfv2::handleStartOperation(LifecycleOperation *operation)
     }
     else
         scheduleAfter(startupTime, startupTimer);
+    simtime_t snapshotSaveTime = par("snapshotSaveTime");
+    if (snapshotSaveTime >= simTime())
+        scheduleAt(snapshotSaveTime, snapshotTimer);
 }
 
 void Ospfv2::handleStopOperation(LifecycleOperation *operation)
@@ -313,6 +360,7 @@ void Ospfv2::handleStopOperation(LifecycleOperation *operation)
     ASSERT(ospfRouter);
     delete ospfRouter;
     cancelEvent(startupTimer);
+    cancelEvent(snapshotTimer);
     ospfRouter = nullptr;
     unsubscribe();
 }
@@ -322,6 +370,7 @@ void Ospfv2::handleCrashOperation(LifecycleOperation *operation)
     ASSERT(ospfRouter);
     delete ospfRouter;
     cancelEvent(startupTimer);
+    cancelEvent(snapshotTimer);
     ospfRouter = nullptr;
     unsubscribe();
 }
@@ -329,6 +378,7 @@ void Ospfv2::handleCrashOperation(LifecycleOperation *operation)
 void Ospfv2::insertExternalRoute(int ifIndex, const Ipv4AddressRange& netAddr)
 {
     Enter_Method("insertExternalRoute");
+    ospfRouter->finishRoutingTableRebuild();
     Ospfv2AsExternalLsaContents newExternalContents;
     newExternalContents.setExternalTOSInfoArraySize(1);
     const Ipv4Address netmask = netAddr.mask;
@@ -346,6 +396,7 @@ void Ospfv2::insertExternalRoute(int ifIndex, const Ipv4AddressRange& netAddr)
 int Ospfv2::checkExternalRoute(const Ipv4Address& route)
 {
     Enter_Method("checkExternalRoute");
+    ospfRouter->finishRoutingTableRebuild();
     for (uint32_t i = 0; i < ospfRouter->getASExternalLSACount(); i++) {
         AsExternalLsa *externalLSA = ospfRouter->getASExternalLSA(i);
         Ipv4Address externalAddr = externalLSA->getHeader().getLinkStateID();
@@ -363,6 +414,12 @@ void Ospfv2::handleInterfaceDown(const NetworkInterface *ie)
 {
     EV_DEBUG << "interface " << ie->getInterfaceId() << " went down. \n";
 
+    // Step 0: switch the routes through this interface to their loop-free alternates before SPF runs
+    if (ospfRouter->isFastRerouteEnabled()) {
+        int promotedCount = ospfRouter->applyFastReroute(ie);
+        EV_DEBUG << "promoted " << promotedCount << " loop-free alternate routes\n";
+    }
+
     // Step 1: delete all direct-routes connected to this interface
 
     // ... from OSPF table
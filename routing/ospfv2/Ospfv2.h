@@ -31,6 +31,7 @@ class INET_API Ospfv2 : public RoutingProtocolBase, protected cListener
     ModuleRefByPar<IInterfaceTable> ift;
     Router *ospfRouter = nullptr; // root object of the OSPF data structure
     cMessage *startupTimer = nullptr; // timer for delayed startup
+    cMessage *snapshotTimer = nullptr; // timer for saving the converged state
 
     /*
      * @sqsq
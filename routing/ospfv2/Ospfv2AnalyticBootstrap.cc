@@ -0,0 +1,187 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#include "inet/routing/ospfv2/Ospfv2AnalyticBootstrap.h"
+
+#include <map>
+
+#include "inet/common/SimulationScopedSingleton.h"
+#include "inet/common/Topology.h"
+#include "inet/routing/ospfv2/Ospfv2Crc.h"
+#include "inet/routing/ospfv2/interface/Ospfv2Interface.h"
+#include "inet/routing/ospfv2/neighbor/Ospfv2Neighbor.h"
+#include "inet/routing/ospfv2/router/Ospfv2Area.h"
+
+namespace inet {
+namespace ospfv2 {
+
+namespace {
+
+/**
+ * Collects the routers registered during the initialization of the current
+ * network. Everything is dropped before a new network is set up.
+ */
+class Ospfv2BootstrapRouters : public SimulationScopedSingleton<Ospfv2BootstrapRouters>
+{
+  protected:
+    virtual void clear() override
+    {
+        routers.clear();
+        done = false;
+    }
+
+  public:
+    std::map<int, Router *> routers; // network node module id -> router
+    bool done = false;
+};
+
+} // namespace
+
+Ospfv2Interface *Ospfv2AnalyticBootstrap::findInterface(Router *router, int interfaceId)
+{
+    for (auto& areaId : router->getAreaIds()) {
+        Ospfv2Area *area = router->getAreaByID(areaId);
+        for (int ifIndex : area->getInterfaceIndices()) {
+            Ospfv2Interface *intf = area->getInterface(ifIndex);
+            if (intf && intf->getIfIndex() == interfaceId)
+                return intf;
+        }
+    }
+    return nullptr;
+}
+
+void Ospfv2AnalyticBootstrap::addFullNeighbor(Ospfv2Interface *intf, Router *neighborRouter, Ospfv2Interface *neighborIntf)
+{
+    // the same values that the neighbor's Hello and Database Description packets would carry
+    RouterId neighborID = neighborRouter->getRouterID();
+    Neighbor *neighbor = intf->getNeighborById(neighborID);
+    if (neighbor == nullptr) {
+        neighbor = new Neighbor(neighborID);
+        intf->addNeighbor(neighbor);
+    }
+    neighbor->setAddress(neighborIntf->getAddressRange().address);
+    neighbor->setPriority(neighborIntf->getRouterPriority());
+    neighbor->setRouterDeadInterval(neighborIntf->getRouterDeadInterval());
+    Ospfv2Options options;
+    options.E_ExternalRoutingCapability = neighborIntf->getArea()->getExternalRoutingCapability();
+    neighbor->setOptions(options);
+    neighbor->setDesignatedRouter(NULL_DESIGNATEDROUTERID);
+    neighbor->setBackupDesignatedRouter(NULL_DESIGNATEDROUTERID);
+    neighbor->setNeiborInitTime(simTime());
+    neighbor->restoreFullState();
+}
+
+void Ospfv2AnalyticBootstrap::reoriginateRouterLsas(Router *router)
+{
+    for (auto& areaId : router->getAreaIds()) {
+        Ospfv2Area *area = router->getAreaByID(areaId);
+        RouterLsa *routerLSA = area->findRouterLSA(router->getRouterID());
+        if (routerLSA == nullptr)
+            continue; // no interface of the area is up
+
+        RouterLsa *newLSA = area->originateRouterLSA();
+        setLsaSequenceNumber(*newLSA, routerLSA->getHeader().getLsSequenceNumber() + 1);
+        routerLSA->update(newLSA);
+        delete newLSA;
+    }
+}
+
+void Ospfv2AnalyticBootstrap::distributeLsas(const std::vector<Router *>& routers)
+{
+    for (auto originator : routers) {
+        RouterId originatorID = originator->getRouterID();
+        for (auto& areaId : originator->getAreaIds()) {
+            Ospfv2Area *area = originator->getAreaByID(areaId);
+            std::vector<const Ospfv2Lsa *> lsas;
+            for (unsigned long i = 0; i < area->getRouterLSACount(); i++)
+                if (area->getRouterLSA(i)->getHeader().getAdvertisingRouter() == originatorID)
+                    lsas.push_back(area->getRouterLSA(i));
+            for (unsigned long i = 0; i < area->getNetworkLSACount(); i++)
+                if (area->getNetworkLSA(i)->getHeader().getAdvertisingRouter() == originatorID)
+                    lsas.push_back(area->getNetworkLSA(i));
+            for (unsigned long i = 0; i < area->getSummaryLSACount(); i++)
+                if (area->getSummaryLSA(i)->getHeader().getAdvertisingRouter() == originatorID)
+                    lsas.push_back(area->getSummaryLSA(i));
+
+            for (auto router : routers) {
+                if (router == originator || router->getAreaByID(areaId) == nullptr)
+                    continue;
+                for (auto lsa : lsas)
+                    router->installLSA(lsa, areaId);
+            }
+        }
+
+        std::vector<const Ospfv2Lsa *> externalLsas;
+        for (unsigned long i = 0; i < originator->getASExternalLSACount(); i++)
+            if (originator->getASExternalLSA(i)->getHeader().getAdvertisingRouter() == originatorID)
+                externalLsas.push_back(originator->getASExternalLSA(i));
+        for (auto router : routers) {
+            if (router == originator)
+                continue;
+            for (auto lsa : externalLsas)
+                router->installLSA(lsa);
+        }
+    }
+}
+
+void Ospfv2AnalyticBootstrap::addRouter(cModule *node, Router *router)
+{
+    Ospfv2BootstrapRouters::getInstance().routers[node->getId()] = router;
+}
+
+void Ospfv2AnalyticBootstrap::bootstrap()
+{
+    auto& bootstrapRouters = Ospfv2BootstrapRouters::getInstance();
+    if (bootstrapRouters.done)
+        return;
+    bootstrapRouters.done = true;
+
+    Topology topology;
+    topology.extractByProperty("networkNode");
+
+    std::vector<Router *> routers;
+    int adjacencyCount = 0;
+    for (int i = 0; i < topology.getNumNodes(); i++) {
+        Topology::Node *node = topology.getNode(i);
+        auto it = bootstrapRouters.routers.find(node->getModuleId());
+        if (it == bootstrapRouters.routers.end())
+            continue;
+        Router *router = it->second;
+        routers.push_back(router);
+
+        // every direction of a link is a separate out link, so only the local end is set up here
+        for (int j = 0; j < node->getNumOutLinks(); j++) {
+            Topology::Link *link = node->getLinkOut(j);
+            auto neighborIt = bootstrapRouters.routers.find(link->getLinkOutRemoteNode()->getModuleId());
+            if (neighborIt == bootstrapRouters.routers.end())
+                continue;
+            Router *neighborRouter = neighborIt->second;
+            NetworkInterface *ie = router->getIft()->findInterfaceByNodeOutputGateId(link->getLinkOutLocalGateId());
+            NetworkInterface *neighborIe = neighborRouter->getIft()->findInterfaceByNodeInputGateId(link->getLinkOutRemoteGateId());
+            if (ie == nullptr || neighborIe == nullptr)
+                continue;
+            Ospfv2Interface *intf = findInterface(router, ie->getInterfaceId());
+            Ospfv2Interface *neighborIntf = findInterface(neighborRouter, neighborIe->getInterfaceId());
+            if (intf == nullptr || neighborIntf == nullptr ||
+                intf->getType() != Ospfv2Interface::POINTTOPOINT || neighborIntf->getType() != Ospfv2Interface::POINTTOPOINT ||
+                intf->getMode() != Ospfv2Interface::ACTIVE || neighborIntf->getMode() != Ospfv2Interface::ACTIVE ||
+                intf->getState() != Ospfv2Interface::POINTTOPOINT_STATE || neighborIntf->getState() != Ospfv2Interface::POINTTOPOINT_STATE ||
+                intf->getAreaId() != neighborIntf->getAreaId())
+                continue;
+            addFullNeighbor(intf, neighborRouter, neighborIntf);
+            adjacencyCount++;
+        }
+    }
+
+    for (auto router : routers)
+        reoriginateRouterLsas(router);
+    distributeLsas(routers);
+    for (auto router : routers)
+        router->rebuildRoutingTable();
+
+    EV_INFO << "OSPF analytic bootstrap: " << routers.size() << " routers, " << adjacencyCount << " adjacencies in FULL state" << endl;
+}
+
+} // namespace ospfv2
+} // namespace inet
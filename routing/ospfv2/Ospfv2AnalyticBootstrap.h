@@ -0,0 +1,54 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#ifndef __INET_OSPFV2ANALYTICBOOTSTRAP_H
+#define __INET_OSPFV2ANALYTICBOOTSTRAP_H
+
+#include <vector>
+
+#include "inet/routing/ospfv2/router/Ospfv2Router.h"
+
+namespace inet {
+
+namespace ospfv2 {
+
+/**
+ * Brings all Ospfv2 routers of the network into the converged state during
+ * initialization, without simulating the Hello/Database Description exchange
+ * and the initial flooding.
+ *
+ * The routers register themselves when they are created. The bootstrap then
+ * discovers the point-to-point links between them with Topology, puts both
+ * ends of each link into FULL state (the Hello and inactivity timers keep
+ * running as in a converged network), re-originates the router LSAs,
+ * copies every self-originated LSA into the databases of the other routers
+ * and finally calculates the routing tables. Links of other interface types
+ * are left to the protocol.
+ */
+class INET_API Ospfv2AnalyticBootstrap
+{
+  private:
+    static Ospfv2Interface *findInterface(Router *router, int interfaceId);
+    static void addFullNeighbor(Ospfv2Interface *intf, Router *neighborRouter, Ospfv2Interface *neighborIntf);
+    static void reoriginateRouterLsas(Router *router);
+    static void distributeLsas(const std::vector<Router *>& routers);
+
+  public:
+    /**
+     * Registers the router of the given network node for the bootstrap.
+     */
+    static void addRouter(cModule *node, Router *router);
+
+    /**
+     * Performs the bootstrap of all registered routers. Only the first call
+     * of each initialization does anything.
+     */
+    static void bootstrap();
+};
+
+} // namespace ospfv2
+
+} // namespace inet
+
+#endif
@@ -0,0 +1,105 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#include "inet/routing/ospfv2/Ospfv2ConfigIndex.h"
+
+#include "inet/common/SimulationScopedSingleton.h"
+#include "inet/common/XMLUtils.h"
+
+namespace inet {
+namespace ospfv2 {
+
+using namespace xmlutils;
+
+namespace {
+
+/**
+ * Keeps the indices of the OSPF configuration documents used in the current
+ * simulation run. The documents are owned by the XML document cache of the
+ * environment, so the indices are dropped before a new network is set up.
+ */
+class Ospfv2ConfigIndexCache : public SimulationScopedSingleton<Ospfv2ConfigIndexCache>
+{
+  private:
+    std::map<const cXMLElement *, Ospfv2ConfigIndex *> indices;
+
+  protected:
+    virtual void clear() override
+    {
+        for (auto& elem : indices)
+            delete elem.second;
+        indices.clear();
+    }
+
+  public:
+    virtual ~Ospfv2ConfigIndexCache() { clear(); }
+
+    const Ospfv2ConfigIndex& getIndex(const cXMLElement *asConfig)
+    {
+        auto it = indices.find(asConfig);
+        if (it == indices.end())
+            it = indices.insert(std::make_pair(asConfig, new Ospfv2ConfigIndex(asConfig))).first;
+        return *it->second;
+    }
+};
+
+} // namespace
+
+Ospfv2ConfigIndex::Ospfv2ConfigIndex(const cXMLElement *asConfig) :
+    asConfig(asConfig)
+{
+    routers = asConfig->getElementsByTagName("Router");
+    for (size_t i = 0; i < routers.size(); i++) {
+        const char *nodeName = getMandatoryFilledAttribute(*routers[i], "name");
+        if (PatternMatcher::containsWildcards(nodeName))
+            routerPatterns.push_back({ i, PatternMatcher(nodeName, true, true, true) });
+        else
+            routerPositionsByName.insert(std::make_pair(std::string(nodeName), i)); // keeps the first one
+    }
+
+    for (auto& child : asConfig->getChildrenByTagName("Area")) {
+        const char *id = child->getAttribute("id");
+        if (id != nullptr)
+            areasById.insert(std::make_pair(std::string(id), child)); // keeps the first one
+    }
+}
+
+cXMLElement *Ospfv2ConfigIndex::findRouterConfig(const std::string& nodeFullPath, const std::string& nodeShortenedFullPath) const
+{
+    size_t position = routers.size();
+
+    auto it = routerPositionsByName.find(nodeFullPath);
+    if (it != routerPositionsByName.end())
+        position = it->second;
+    it = routerPositionsByName.find(nodeShortenedFullPath);
+    if (it != routerPositionsByName.end() && it->second < position)
+        position = it->second;
+
+    // a wildcard Router element preceding the exact match takes precedence
+    for (auto& routerPattern : routerPatterns) {
+        if (routerPattern.position >= position)
+            break;
+        if (routerPattern.matcher.matches(nodeFullPath.c_str()) || routerPattern.matcher.matches(nodeShortenedFullPath.c_str())) {
+            position = routerPattern.position;
+            break;
+        }
+    }
+
+    return position < routers.size() ? routers[position] : nullptr;
+}
+
+cXMLElement *Ospfv2ConfigIndex::findAreaConfig(AreaId areaID) const
+{
+    auto it = areasById.find(areaID.str(false));
+    return it != areasById.end() ? it->second : nullptr;
+}
+
+const Ospfv2ConfigIndex& Ospfv2ConfigIndex::getIndex(const cXMLElement *asConfig)
+{
+    return Ospfv2ConfigIndexCache::getInstance().getIndex(asConfig);
+}
+
+} // namespace ospfv2
+} // namespace inet
+
@@ -0,0 +1,71 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#ifndef __INET_OSPFV2CONFIGINDEX_H
+#define __INET_OSPFV2CONFIGINDEX_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "inet/common/PatternMatcher.h"
+#include "inet/routing/ospfv2/router/Ospfv2Common.h"
+
+namespace inet {
+
+namespace ospfv2 {
+
+/**
+ * Index over an <OSPFASConfig> document, built once and shared by all Ospfv2
+ * modules which use the same document. It replaces the per-router scan over
+ * all <Router> elements (and the XPath lookup of <Area> elements), which made
+ * the startup of large networks quadratic in the number of routers.
+ *
+ * Router elements whose name does not contain wildcards are looked up by name,
+ * the remaining ones are matched in document order, like before.
+ */
+class INET_API Ospfv2ConfigIndex
+{
+  private:
+    struct RouterPattern {
+        size_t position; // position of the Router element in document order
+        PatternMatcher matcher;
+    };
+
+    const cXMLElement *asConfig = nullptr;
+    std::vector<cXMLElement *> routers; // Router elements in document order
+    std::map<std::string, size_t> routerPositionsByName; // Router@name without wildcards -> first position
+    std::vector<RouterPattern> routerPatterns; // Router@name with wildcards, in document order
+    std::map<std::string, cXMLElement *> areasById; // Area@id -> first Area element
+
+  public:
+    Ospfv2ConfigIndex(const cXMLElement *asConfig);
+
+    const cXMLElement *getAsConfig() const { return asConfig; }
+    size_t getNumRouters() const { return routers.size(); }
+
+    /**
+     * Returns the first Router element in document order whose name matches
+     * either of the input paths, or nullptr if there is no such element.
+     */
+    cXMLElement *findRouterConfig(const std::string& nodeFullPath, const std::string& nodeShortenedFullPath) const;
+
+    /**
+     * Returns the Area element with the given ID, or nullptr if there is no such element.
+     */
+    cXMLElement *findAreaConfig(AreaId areaID) const;
+
+    /**
+     * Returns the index of the input document. The index is built on first
+     * use and shared until the next network is set up.
+     */
+    static const Ospfv2ConfigIndex& getIndex(const cXMLElement *asConfig);
+};
+
+} // namespace ospfv2
+
+} // namespace inet
+
+#endif
+
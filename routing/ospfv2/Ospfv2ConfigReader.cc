@@ -54,16 +54,8 @@ bool Ospfv2ConfigReader::loadConfigFromXML(cXMLElement *asConfig, Router *ospfRo
     std::string nodeShortenedFullPath = nodeFullPath.substr(nodeFullPath.find('.') + 1);
 
     // load information on this router
-    cXMLElementList routers = asConfig->getElementsByTagName("Router");
-    cXMLElement *routerNode = nullptr;
-    for (auto& router : routers) {
-        const char *nodeName = getMandatoryFilledAttribute(*(router), "name");
-        inet::PatternMatcher pattern(nodeName, true, true, true);
-        if (pattern.matches(nodeFullPath.c_str()) || pattern.matches(nodeShortenedFullPath.c_str())) { // match Router@name and fullpath of my node
-            routerNode = router;
-            break;
-        }
-    }
+    configIndex = &Ospfv2ConfigIndex::getIndex(asConfig);
+    cXMLElement *routerNode = configIndex->findRouterConfig(nodeFullPath, nodeShortenedFullPath); // match Router@name and fullpath of my node
     if (routerNode == nullptr) {
         throw cRuntimeError("No configuration for Router '%s' at '%s'", nodeFullPath.c_str(), asConfig->getSourceLocation());
     }
@@ -148,13 +140,9 @@ void Ospfv2ConfigReader::getAreaListFromXML(const cXMLElement& routerNode, std::
 
 void Ospfv2ConfigReader::loadAreaFromXML(const cXMLElement& asConfig, AreaId areaID)
 {
-    std::string areaXPath("Area[@id='");
-    areaXPath += areaID.str(false);
-    areaXPath += "']";
-
     auto crcMode = parseCrcMode(par("crcMode"), false);
 
-    cXMLElement *areaConfig = asConfig.getElementByPath(areaXPath.c_str());
+    cXMLElement *areaConfig = configIndex->findAreaConfig(areaID);
     if (areaConfig == nullptr) {
         if (areaID != Ipv4Address("0.0.0.0"))
             throw cRuntimeError("No configuration for Area ID: %s at %s", areaID.str(false).c_str(), asConfig.getSourceLocation());
@@ -11,6 +11,7 @@
 
 #include "inet/networklayer/contract/IInterfaceTable.h"
 #include "inet/networklayer/ipv4/IIpv4RoutingTable.h"
+#include "inet/routing/ospfv2/Ospfv2ConfigIndex.h"
 #include "inet/routing/ospfv2/Ospfv2Packet_m.h"
 #include "inet/routing/ospfv2/router/Ospfv2Router.h"
 
@@ -27,6 +28,7 @@ class INET_API Ospfv2ConfigReader
     cModule *ospfModule = nullptr;
     IInterfaceTable *ift = nullptr; // provides access to the interface table
     Router *ospfRouter = nullptr; // data structure to fill in
+    const Ospfv2ConfigIndex *configIndex = nullptr; // shared index of the AS configuration
 
   private:
     cPar& par(const char *name) const { return ospfModule->par(name); }
@@ -7,6 +7,7 @@
 
 #include "inet/routing/ospfv2/Ospfv2Crc.h"
 
+#include "inet/common/checksum/FletcherChecksum.h"
 #include "inet/common/checksum/TcpIpChecksum.h"
 #include "inet/routing/ospfv2/Ospfv2PacketSerializer.h"
 #include "inet/routing/ospfv2/router/Ospfv2Common.h"
@@ -14,6 +15,28 @@
 namespace inet {
 namespace ospfv2 {
 
+namespace {
+
+// RFC 2328 12.1.7: the LS checksum covers the LSA except the LS age, so offsets are relative to the 3rd octet
+const size_t LSA_CHECKSUM_START = 2;
+const size_t LSA_CHECKSUM_OFFSET = 16 - LSA_CHECKSUM_START;
+const size_t LSA_SEQUENCE_NUMBER_OFFSET = 12;
+const size_t LSA_HEADER_SIZE = 20;
+
+void updateLsaCrc(Ospfv2Lsa& lsa, size_t offset, uint32_t oldValue, uint32_t newValue, size_t size)
+{
+    auto& lsaHeader = lsa.getHeaderForUpdate();
+    uint8_t oldBytes[4], newBytes[4];
+    for (size_t i = 0; i < size; i++) {
+        oldBytes[i] = (oldValue >> (8 * (size - 1 - i))) & 0xFF;
+        newBytes[i] = (newValue >> (8 * (size - 1 - i))) & 0xFF;
+    }
+    size_t length = lsaHeader.getLsaLength() - LSA_CHECKSUM_START;
+    lsaHeader.setLsCrc(FletcherChecksum::update(lsaHeader.getLsCrc(), length, LSA_CHECKSUM_OFFSET, offset - LSA_CHECKSUM_START, oldBytes, newBytes, size));
+}
+
+} // namespace
+
 void setOspfCrc(const Ptr<Ospfv2Packet>& ospfPacket, CrcMode crcMode)
 {
     ospfPacket->setCrcMode(crcMode);
@@ -60,11 +83,9 @@ void setLsaCrc(Ospfv2Lsa& lsa, CrcMode crcMode)
         case CrcMode::CRC_COMPUTED: {
             lsaHeader.setLsCrc(0);
             MemoryOutputStream stream;
-            auto lsAge = lsaHeader.getLsAge();
-            lsaHeader.setLsAge(0); // disable lsAge from CRC
             Ospfv2PacketSerializer::serializeLsa(stream, lsa);
-            uint16_t crc = TcpIpChecksum::checksum(stream.getData());
-            lsaHeader.setLsAge(lsAge); // restore lsAge
+            const auto& bytes = stream.getData();
+            uint16_t crc = FletcherChecksum::checksum(bytes.data() + LSA_CHECKSUM_START, bytes.size() - LSA_CHECKSUM_START, LSA_CHECKSUM_OFFSET);
             lsaHeader.setLsCrc(crc);
             break;
         }
@@ -99,6 +120,45 @@ void setLsaHeaderCrc(Ospfv2LsaHeader& lsaHeader, CrcMode crcMode)
     }
 }
 
+bool validateLsaCrc(const Ospfv2Lsa& lsa)
+{
+    switch (lsa.getHeader().getLsCrcMode()) {
+        case CrcMode::CRC_DECLARED_INCORRECT:
+            return false;
+        case CrcMode::CRC_COMPUTED: {
+            MemoryOutputStream stream;
+            Ospfv2PacketSerializer::serializeLsa(stream, lsa);
+            const auto& bytes = stream.getData();
+            return FletcherChecksum::verify(bytes.data() + LSA_CHECKSUM_START, bytes.size() - LSA_CHECKSUM_START);
+        }
+        default:
+            return true;
+    }
+}
+
+void setLsaSequenceNumber(Ospfv2Lsa& lsa, uint32_t sequenceNumber)
+{
+    auto& lsaHeader = lsa.getHeaderForUpdate();
+    uint32_t oldSequenceNumber = lsaHeader.getLsSequenceNumber();
+    lsaHeader.setLsSequenceNumber(sequenceNumber);
+    if (lsaHeader.getLsCrcMode() == CrcMode::CRC_COMPUTED)
+        updateLsaCrc(lsa, LSA_SEQUENCE_NUMBER_OFFSET, oldSequenceNumber, sequenceNumber, 4);
+}
+
+void setRouterLsaLinkCost(Ospfv2RouterLsa& lsa, size_t linkIndex, uint16_t cost)
+{
+    // flags, reserved, number of links, then links of 12 octets each, followed by their TOS entries
+    size_t offset = LSA_HEADER_SIZE + 4;
+    for (size_t i = 0; i < linkIndex; i++)
+        offset += 12 + 4 * lsa.getLinks(i).getTosDataArraySize();
+    offset += 10;
+    auto& link = lsa.getLinksForUpdate(linkIndex);
+    uint16_t oldCost = link.getLinkCost();
+    link.setLinkCost(cost);
+    if (lsa.getHeader().getLsCrcMode() == CrcMode::CRC_COMPUTED)
+        updateLsaCrc(lsa, offset, oldCost, cost, 2);
+}
+
 } // namespace ospfv2
 } // namespace inet
 
@@ -20,6 +20,20 @@ INET_API void setOspfCrc(const Ptr<Ospfv2Packet>& ospfPacket, CrcMode crcMode);
 INET_API void setLsaCrc(Ospfv2Lsa& lsa, CrcMode crcMode);
 INET_API void setLsaHeaderCrc(Ospfv2LsaHeader& lsaHeader, CrcMode crcMode);
 
+/**
+ * Checks the LS checksum of the LSA (RFC 2328 Section 12.1.7). Declared
+ * checksums are accepted as declared, computed ones are verified against
+ * the serialized LSA.
+ */
+INET_API bool validateLsaCrc(const Ospfv2Lsa& lsa);
+
+/**
+ * Setters for LSA fields that keep a computed LS checksum valid by updating
+ * it incrementally, instead of serializing the whole LSA again.
+ */
+INET_API void setLsaSequenceNumber(Ospfv2Lsa& lsa, uint32_t sequenceNumber);
+INET_API void setRouterLsaLinkCost(Ospfv2RouterLsa& lsa, size_t linkIndex, uint16_t cost);
+
 } // namespace ospfv2
 
 } // namespace inet
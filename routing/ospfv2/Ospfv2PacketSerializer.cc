@@ -71,7 +71,7 @@ void Ospfv2PacketSerializer::serialize(MemoryOutputStream& stream, const Ptr<con
             const auto& updatePacket = staticPtrCast<const Ospfv2LinkStateUpdatePacket>(ospfPacket);
             stream.writeUint32Be(updatePacket->getOspfLSAsArraySize());
             for (size_t i = 0; i < updatePacket->getOspfLSAsArraySize(); ++i) {
-                serializeLsa(stream, *updatePacket->getOspfLSAs(i));
+                serializeLsaCached(stream, *updatePacket->getOspfLSAs(i));
             }
             break;
         }
@@ -431,6 +431,35 @@ void Ospfv2PacketSerializer::serializeLsa(MemoryOutputStream& stream, const Ospf
     }
 }
 
+void Ospfv2PacketSerializer::serializeLsaCached(MemoryOutputStream& stream, const Ospfv2Lsa& lsa)
+{
+    auto& lsaHeader = lsa.getHeader();
+    // only computed checksums track the contents, declared ones cannot be serialized anyway
+    if (lsaHeader.getLsCrcMode() != CRC_COMPUTED) {
+        serializeLsa(stream, lsa);
+        return;
+    }
+    // the encoding is kept in the LSA object itself, so the different instances
+    // of the same LSA kept by different routers never share their bytes
+    auto& encoding = lsa.getWireEncoding();
+    if (!encoding.bytes.empty() && encoding.lsSequenceNumber == lsaHeader.getLsSequenceNumber() &&
+        encoding.lsCrc == lsaHeader.getLsCrc() && encoding.lsaLength == lsaHeader.getLsaLength())
+    {
+        stream.writeUint16Be(lsaHeader.getLsAge());
+        stream.writeBytes(encoding.bytes, B(2));
+    }
+    else {
+        B start = B(stream.getLength());
+        serializeLsa(stream, lsa);
+        B length = B(stream.getLength()) - start;
+        encoding.lsSequenceNumber = lsaHeader.getLsSequenceNumber();
+        encoding.lsCrc = lsaHeader.getLsCrc();
+        encoding.lsaLength = lsaHeader.getLsaLength();
+        const uint8_t *bytes = stream.getData().data() + start.get();
+        encoding.bytes.assign(bytes, bytes + length.get());
+    }
+}
+
 void Ospfv2PacketSerializer::deserializeLsa(MemoryInputStream& stream, const Ptr<Ospfv2LinkStateUpdatePacket> updatePacket, int i)
 {
     Ospfv2LsaHeader *lsaHeader = new Ospfv2LsaHeader();
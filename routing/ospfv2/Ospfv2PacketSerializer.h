@@ -40,11 +40,15 @@ class INET_API Ospfv2PacketSerializer : public FieldsChunkSerializer
     static void serializeAsExternalLsa(MemoryOutputStream& stream, const Ospfv2AsExternalLsa& asExternalLsa);
     static void deserializeAsExternalLsa(MemoryInputStream& stream, const Ptr<Ospfv2LinkStateUpdatePacket> updatePacket, Ospfv2AsExternalLsa& asExternalLsa);
 
-    static void serializeOspfOptions(MemoryOutputStream& stream, const Ospfv2Options& options);
-    static void deserializeOspfOptions(MemoryInputStream& stream, Ospfv2Options& options);
-
     static void copyHeaderFields(const Ptr<Ospfv2Packet> from, Ptr<Ospfv2Packet> to);
 
+    /**
+     * Writes the wire encoding of the LSA, reusing the bytes kept in the LSA
+     * object by an earlier call if its LS sequence number, checksum and length
+     * have not changed since. Only the LS age is written again.
+     */
+    static void serializeLsaCached(MemoryOutputStream& stream, const Ospfv2Lsa& lsa);
+
   protected:
     virtual void serialize(MemoryOutputStream& stream, const Ptr<const Chunk>& chunk) const override;
     virtual const Ptr<Chunk> deserialize(MemoryInputStream& stream) const override;
@@ -52,10 +56,16 @@ class INET_API Ospfv2PacketSerializer : public FieldsChunkSerializer
   public:
     Ospfv2PacketSerializer() : FieldsChunkSerializer() {}
 
+    /**
+     * Serializes the LSA from its fields, never from the wire encoding cache,
+     * so it is suitable for computing the LS checksum.
+     */
     static void serializeLsa(MemoryOutputStream& stream, const Ospfv2Lsa& routerLsa);
     static void deserializeLsa(MemoryInputStream& stream, const Ptr<Ospfv2LinkStateUpdatePacket> updatePacket, int i);
     static void serializeLsaHeader(MemoryOutputStream& stream, const Ospfv2LsaHeader& lsaHeader);
     static void deserializeLsaHeader(MemoryInputStream& stream, Ospfv2LsaHeader& lsaHeader);
+    static void serializeOspfOptions(MemoryOutputStream& stream, const Ospfv2Options& options);
+    static void deserializeOspfOptions(MemoryInputStream& stream, Ospfv2Options& options);
 
     // TODO kludge, should register Ospfv2PacketSerializer to OspfPacketSerializer later.
     friend class inet::ospf::OspfPacketSerializer;
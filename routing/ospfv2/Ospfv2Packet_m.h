@@ -416,13 +416,33 @@ class INET_API Ospfv2Lsa : public ::omnetpp::cObject
     virtual const Ospfv2LsaHeader& getHeader() const;
     virtual Ospfv2LsaHeader& getHeaderForUpdate() { return const_cast<Ospfv2LsaHeader&>(const_cast<Ospfv2Lsa*>(this)->getHeader());}
     virtual void setHeader(const Ospfv2LsaHeader& header);
+
+
+  public:
+    /**
+     * The wire encoding of this LSA instance without the LS age, see
+     * Ospfv2PacketSerializer::serializeLsaCached(). It is only valid while
+     * the LS sequence number, checksum and length match the header.
+     */
+    struct WireEncoding {
+        int32_t lsSequenceNumber = 0;
+        uint16_t lsCrc = 0;
+        uint16_t lsaLength = 0;
+        std::vector<uint8_t> bytes;
+    };
+
+  private:
+    mutable WireEncoding wireEncoding; // not copied, copies start without an encoding
+
+  public:
+    WireEncoding& getWireEncoding() const { return wireEncoding; }
 };
 
 inline void doParsimPacking(omnetpp::cCommBuffer *b, const Ospfv2Lsa& obj) {obj.parsimPack(b);}
 inline void doParsimUnpacking(omnetpp::cCommBuffer *b, Ospfv2Lsa& obj) {obj.parsimUnpack(b);}
 
 /**
- * Enum generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:118</tt> by opp_msgtool.
+ * Enum generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:139</tt> by opp_msgtool.
  * <pre>
  * enum LinkType
  * {
@@ -444,7 +464,7 @@ inline void doParsimPacking(omnetpp::cCommBuffer *b, const LinkType& e) { b->pac
 inline void doParsimUnpacking(omnetpp::cCommBuffer *b, LinkType& e) { int n; b->unpack(n); e = static_cast<LinkType>(n); }
 
 /**
- * Struct generated from inet/routing/ospfv2/Ospfv2Packet.msg:127 by opp_msgtool.
+ * Struct generated from inet/routing/ospfv2/Ospfv2Packet.msg:148 by opp_msgtool.
  */
 struct INET_API Ospfv2TosData
 {
@@ -461,7 +481,7 @@ inline void doParsimPacking(omnetpp::cCommBuffer *b, const Ospfv2TosData& obj) {
 inline void doParsimUnpacking(omnetpp::cCommBuffer *b, Ospfv2TosData& obj) { __doUnpacking(b, obj); }
 
 /**
- * Class generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:135</tt> by opp_msgtool.
+ * Class generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:156</tt> by opp_msgtool.
  * <pre>
  * // Router LSA Link section (RFC 1583 Section A.4.2.)
  * class Ospfv2Link extends cObject
@@ -533,7 +553,7 @@ inline void doParsimPacking(omnetpp::cCommBuffer *b, const Ospfv2Link& obj) {obj
 inline void doParsimUnpacking(omnetpp::cCommBuffer *b, Ospfv2Link& obj) {obj.parsimUnpack(b);}
 
 /**
- * Class generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:149</tt> by opp_msgtool.
+ * Class generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:170</tt> by opp_msgtool.
  * <pre>
  * //
  * // Represents an OSPF Router LSA (RFC 1583 Section A.4.2.)
@@ -611,7 +631,7 @@ inline void doParsimPacking(omnetpp::cCommBuffer *b, const Ospfv2RouterLsa& obj)
 inline void doParsimUnpacking(omnetpp::cCommBuffer *b, Ospfv2RouterLsa& obj) {obj.parsimUnpack(b);}
 
 /**
- * Class generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:164</tt> by opp_msgtool.
+ * Class generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:185</tt> by opp_msgtool.
  * <pre>
  * //
  * // Represents an OSPF Network LSA
@@ -665,7 +685,7 @@ inline void doParsimPacking(omnetpp::cCommBuffer *b, const Ospfv2NetworkLsa& obj
 inline void doParsimUnpacking(omnetpp::cCommBuffer *b, Ospfv2NetworkLsa& obj) {obj.parsimUnpack(b);}
 
 /**
- * Class generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:174</tt> by opp_msgtool.
+ * Class generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:195</tt> by opp_msgtool.
  * <pre>
  * //
  * // Represents an OSPF Summary LSA
@@ -724,7 +744,7 @@ inline void doParsimPacking(omnetpp::cCommBuffer *b, const Ospfv2SummaryLsa& obj
 inline void doParsimUnpacking(omnetpp::cCommBuffer *b, Ospfv2SummaryLsa& obj) {obj.parsimUnpack(b);}
 
 /**
- * Struct generated from inet/routing/ospfv2/Ospfv2Packet.msg:182 by opp_msgtool.
+ * Struct generated from inet/routing/ospfv2/Ospfv2Packet.msg:203 by opp_msgtool.
  */
 struct INET_API Ospfv2ExternalTosInfo
 {
@@ -744,7 +764,7 @@ inline void doParsimPacking(omnetpp::cCommBuffer *b, const Ospfv2ExternalTosInfo
 inline void doParsimUnpacking(omnetpp::cCommBuffer *b, Ospfv2ExternalTosInfo& obj) { __doUnpacking(b, obj); }
 
 /**
- * Class generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:196</tt> by opp_msgtool.
+ * Class generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:217</tt> by opp_msgtool.
  * <pre>
  * //
  * // Represents the contents of an OSPF AS External LSA
@@ -798,7 +818,7 @@ inline void doParsimPacking(omnetpp::cCommBuffer *b, const Ospfv2AsExternalLsaCo
 inline void doParsimUnpacking(omnetpp::cCommBuffer *b, Ospfv2AsExternalLsaContents& obj) {obj.parsimUnpack(b);}
 
 /**
- * Class generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:206</tt> by opp_msgtool.
+ * Class generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:227</tt> by opp_msgtool.
  * <pre>
  * //
  * // Represents an OSPF AS External LSA
@@ -839,7 +859,7 @@ inline void doParsimPacking(omnetpp::cCommBuffer *b, const Ospfv2AsExternalLsa&
 inline void doParsimUnpacking(omnetpp::cCommBuffer *b, Ospfv2AsExternalLsa& obj) {obj.parsimUnpack(b);}
 
 /**
- * Struct generated from inet/routing/ospfv2/Ospfv2Packet.msg:213 by opp_msgtool.
+ * Struct generated from inet/routing/ospfv2/Ospfv2Packet.msg:234 by opp_msgtool.
  */
 struct INET_API Ospfv2DdOptions
 {
@@ -858,7 +878,7 @@ inline void doParsimPacking(omnetpp::cCommBuffer *b, const Ospfv2DdOptions& obj)
 inline void doParsimUnpacking(omnetpp::cCommBuffer *b, Ospfv2DdOptions& obj) { __doUnpacking(b, obj); }
 
 /**
- * Class generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:225</tt> by opp_msgtool.
+ * Class generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:246</tt> by opp_msgtool.
  * <pre>
  * //
  * // Represents an OSPF Database Description packet
@@ -927,7 +947,7 @@ inline void doParsimPacking(omnetpp::cCommBuffer *b, const Ospfv2DatabaseDescrip
 inline void doParsimUnpacking(omnetpp::cCommBuffer *b, Ospfv2DatabaseDescriptionPacket& obj) {obj.parsimUnpack(b);}
 
 /**
- * Struct generated from inet/routing/ospfv2/Ospfv2Packet.msg:234 by opp_msgtool.
+ * Struct generated from inet/routing/ospfv2/Ospfv2Packet.msg:255 by opp_msgtool.
  */
 struct INET_API Ospfv2LsaRequest
 {
@@ -945,7 +965,7 @@ inline void doParsimPacking(omnetpp::cCommBuffer *b, const Ospfv2LsaRequest& obj
 inline void doParsimUnpacking(omnetpp::cCommBuffer *b, Ospfv2LsaRequest& obj) { __doUnpacking(b, obj); }
 
 /**
- * Class generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:245</tt> by opp_msgtool.
+ * Class generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:266</tt> by opp_msgtool.
  * <pre>
  * //
  * // Represents an OSPF Link State Request packet
@@ -992,7 +1012,7 @@ inline void doParsimPacking(omnetpp::cCommBuffer *b, const Ospfv2LinkStateReques
 inline void doParsimUnpacking(omnetpp::cCommBuffer *b, Ospfv2LinkStateRequestPacket& obj) {obj.parsimUnpack(b);}
 
 /**
- * Class generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:253</tt> by opp_msgtool.
+ * Class generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:274</tt> by opp_msgtool.
  * <pre>
  * //
  * // Represents an OSPF Link State Update packet
@@ -1041,7 +1061,7 @@ inline void doParsimPacking(omnetpp::cCommBuffer *b, const Ospfv2LinkStateUpdate
 inline void doParsimUnpacking(omnetpp::cCommBuffer *b, Ospfv2LinkStateUpdatePacket& obj) {obj.parsimUnpack(b);}
 
 /**
- * Class generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:261</tt> by opp_msgtool.
+ * Class generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:282</tt> by opp_msgtool.
  * <pre>
  * //
  * // Represents an OSPF Link State Acknowledgement packet
@@ -1088,7 +1108,7 @@ inline void doParsimPacking(omnetpp::cCommBuffer *b, const Ospfv2LinkStateAcknow
 inline void doParsimUnpacking(omnetpp::cCommBuffer *b, Ospfv2LinkStateAcknowledgementPacket& obj) {obj.parsimUnpack(b);}
 
 /**
- * Class generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:269</tt> by opp_msgtool.
+ * Class generated from <tt>inet/routing/ospfv2/Ospfv2Packet.msg:290</tt> by opp_msgtool.
  * <pre>
  * //
  * // \@sqsq
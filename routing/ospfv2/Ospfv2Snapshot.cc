@@ -0,0 +1,274 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#include "inet/routing/ospfv2/Ospfv2Snapshot.h"
+
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+
+#include "inet/common/SimulationScopedSingleton.h"
+#include "inet/routing/ospfv2/Ospfv2PacketSerializer.h"
+
+namespace inet {
+namespace ospfv2 {
+
+namespace {
+
+const char SNAPSHOT_MAGIC[] = "OSPFSNP1";
+
+typedef std::map<std::string, std::vector<uint8_t>> SnapshotRecords; // router path -> router state
+
+/**
+ * Keeps the snapshot files of the current run: the ones being saved are
+ * written when the network finishes, the ones being restored are read on
+ * first use. Everything is dropped before a new network is set up.
+ */
+class Ospfv2SnapshotFiles : public SimulationScopedSingleton<Ospfv2SnapshotFiles>
+{
+  private:
+    std::map<std::string, SnapshotRecords> savedFiles;
+    std::map<std::string, SnapshotRecords> loadedFiles;
+
+    static void writeFile(const std::string& fileName, const SnapshotRecords& records)
+    {
+        MemoryOutputStream stream;
+        stream.writeBytes(reinterpret_cast<const uint8_t *>(SNAPSHOT_MAGIC), B(8));
+        stream.writeUint32Be(records.size());
+        for (auto& elem : records) {
+            stream.writeString(elem.first);
+            stream.writeUint32Be(elem.second.size());
+            stream.writeBytes(elem.second);
+        }
+        std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+        const auto& data = stream.getData();
+        file.write(reinterpret_cast<const char *>(data.data()), data.size());
+        if (!file)
+            throw cRuntimeError("Cannot write OSPF snapshot file '%s'", fileName.c_str());
+    }
+
+    static void readFile(const std::string& fileName, SnapshotRecords& records)
+    {
+        std::ifstream file(fileName, std::ios::binary);
+        if (!file)
+            throw cRuntimeError("Cannot open OSPF snapshot file '%s'", fileName.c_str());
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        MemoryInputStream stream(data);
+        uint8_t magic[8];
+        stream.readBytes(magic, B(8));
+        if (stream.isReadBeyondEnd() || memcmp(magic, SNAPSHOT_MAGIC, 8) != 0)
+            throw cRuntimeError("'%s' is not an OSPF snapshot file", fileName.c_str());
+        uint32_t recordCount = stream.readUint32Be();
+        for (uint32_t i = 0; i < recordCount; i++) {
+            std::string routerPath = stream.readString();
+            uint32_t length = stream.readUint32Be();
+            stream.readBytes(records[routerPath], B(length));
+        }
+        if (stream.isReadBeyondEnd())
+            throw cRuntimeError("OSPF snapshot file '%s' is truncated", fileName.c_str());
+    }
+
+  protected:
+    virtual void clear() override
+    {
+        savedFiles.clear();
+        loadedFiles.clear();
+    }
+
+  public:
+    std::vector<uint8_t>& addRecord(const std::string& fileName, const std::string& routerPath)
+    {
+        return savedFiles[fileName][routerPath];
+    }
+
+    const std::vector<uint8_t>& getRecord(const std::string& fileName, const std::string& routerPath)
+    {
+        auto it = loadedFiles.find(fileName);
+        if (it == loadedFiles.end()) {
+            it = loadedFiles.insert(std::make_pair(fileName, SnapshotRecords())).first;
+            readFile(fileName, it->second);
+        }
+        auto recordIt = it->second.find(routerPath);
+        if (recordIt == it->second.end())
+            throw cRuntimeError("OSPF snapshot file '%s' contains no state for '%s'", fileName.c_str(), routerPath.c_str());
+        return recordIt->second;
+    }
+
+    virtual void lifecycleEvent(SimulationLifecycleEventType eventType, cObject *details) override
+    {
+        if (eventType == LF_PRE_NETWORK_FINISH) {
+            for (auto& elem : savedFiles)
+                writeFile(elem.first, elem.second);
+            savedFiles.clear();
+        }
+        SimulationScopedSingleton::lifecycleEvent(eventType, details);
+    }
+};
+
+} // namespace
+
+void Ospfv2Snapshot::writeLsa(MemoryOutputStream& stream, const Ospfv2Lsa& lsa)
+{
+    // the serializer only accepts computed checksums, the original mode and value are stored separately
+    auto lsaHeader = lsa.getHeader();
+    stream.writeByte(lsaHeader.getLsCrcMode());
+    stream.writeUint16Be(lsaHeader.getLsCrc());
+    if (lsaHeader.getLsCrcMode() == CRC_COMPUTED)
+        Ospfv2PacketSerializer::serializeLsa(stream, lsa);
+    else {
+        Ospfv2Lsa *copy = lsa.dup();
+        copy->getHeaderForUpdate().setLsCrcMode(CRC_COMPUTED);
+        Ospfv2PacketSerializer::serializeLsa(stream, *copy);
+        delete copy;
+    }
+}
+
+void Ospfv2Snapshot::readAndInstallLsa(MemoryInputStream& stream, Router *router, AreaId areaID)
+{
+    auto crcMode = static_cast<CrcMode>(stream.readByte());
+    uint16_t crc = stream.readUint16Be();
+    auto updatePacket = makeShared<Ospfv2LinkStateUpdatePacket>();
+    updatePacket->setOspfLSAsArraySize(1);
+    Ospfv2PacketSerializer::deserializeLsa(stream, updatePacket, 0);
+    if (!updatePacket->isCorrect() || stream.isReadBeyondEnd())
+        throw cRuntimeError("Corrupt LSA in OSPF snapshot");
+    Ospfv2Lsa *lsa = updatePacket->getOspfLSAsForUpdate(0);
+    lsa->getHeaderForUpdate().setLsCrcMode(crcMode);
+    lsa->getHeaderForUpdate().setLsCrc(crc);
+    router->installLSA(lsa, areaID);
+}
+
+void Ospfv2Snapshot::writeRouter(MemoryOutputStream& stream, Router *router)
+{
+    stream.writeIpv4Address(router->getRouterID());
+
+    std::vector<AreaId> areaIds = router->getAreaIds();
+    stream.writeUint32Be(areaIds.size());
+    for (auto& areaId : areaIds) {
+        Ospfv2Area *area = router->getAreaByID(areaId);
+        stream.writeIpv4Address(areaId);
+
+        stream.writeUint32Be(area->getRouterLSACount() + area->getNetworkLSACount() + area->getSummaryLSACount());
+        for (unsigned long i = 0; i < area->getRouterLSACount(); i++)
+            writeLsa(stream, *area->getRouterLSA(i));
+        for (unsigned long i = 0; i < area->getNetworkLSACount(); i++)
+            writeLsa(stream, *area->getNetworkLSA(i));
+        for (unsigned long i = 0; i < area->getSummaryLSACount(); i++)
+            writeLsa(stream, *area->getSummaryLSA(i));
+
+        std::vector<int> ifIndices = area->getInterfaceIndices();
+        stream.writeUint32Be(ifIndices.size());
+        for (int ifIndex : ifIndices) {
+            Ospfv2Interface *intf = area->getInterface(ifIndex);
+            std::vector<Neighbor *> fullNeighbors;
+            for (unsigned long i = 0; i < intf->getNeighborCount(); i++) {
+                if (intf->getNeighbor(i)->getState() == Neighbor::FULL_STATE)
+                    fullNeighbors.push_back(intf->getNeighbor(i));
+            }
+            stream.writeUint32Be(intf->getIfIndex());
+            stream.writeUint32Be(fullNeighbors.size());
+            for (auto neighbor : fullNeighbors) {
+                stream.writeIpv4Address(neighbor->getNeighborID());
+                stream.writeIpv4Address(neighbor->getAddress());
+                stream.writeByte(neighbor->getPriority());
+                Ospfv2PacketSerializer::serializeOspfOptions(stream, neighbor->getOptions());
+                stream.writeIpv4Address(neighbor->getDesignatedRouter().routerID);
+                stream.writeIpv4Address(neighbor->getDesignatedRouter().ipInterfaceAddress);
+                stream.writeIpv4Address(neighbor->getBackupDesignatedRouter().routerID);
+                stream.writeIpv4Address(neighbor->getBackupDesignatedRouter().ipInterfaceAddress);
+                stream.writeUint16Be(neighbor->getRouterDeadInterval());
+            }
+        }
+    }
+
+    stream.writeUint32Be(router->getASExternalLSACount());
+    for (unsigned long i = 0; i < router->getASExternalLSACount(); i++)
+        writeLsa(stream, *router->getASExternalLSA(i));
+}
+
+void Ospfv2Snapshot::readRouter(MemoryInputStream& stream, Router *router)
+{
+    RouterId routerID = stream.readIpv4Address();
+    if (routerID != router->getRouterID())
+        throw cRuntimeError("OSPF snapshot was taken from router %s, not from %s", routerID.str(false).c_str(), router->getRouterID().str(false).c_str());
+
+    uint32_t areaCount = stream.readUint32Be();
+    for (uint32_t i = 0; i < areaCount; i++) {
+        AreaId areaId = stream.readIpv4Address();
+        Ospfv2Area *area = router->getAreaByID(areaId);
+        if (area == nullptr)
+            throw cRuntimeError("OSPF snapshot contains unknown area %s", areaId.str(false).c_str());
+
+        uint32_t lsaCount = stream.readUint32Be();
+        for (uint32_t j = 0; j < lsaCount; j++)
+            readAndInstallLsa(stream, router, areaId);
+
+        uint32_t interfaceCount = stream.readUint32Be();
+        for (uint32_t j = 0; j < interfaceCount; j++) {
+            int ifIndex = stream.readUint32Be();
+            Ospfv2Interface *intf = nullptr;
+            for (int index : area->getInterfaceIndices()) {
+                Ospfv2Interface *candidate = area->getInterface(index);
+                if (candidate && candidate->getIfIndex() == ifIndex) {
+                    intf = candidate;
+                    break;
+                }
+            }
+            if (intf == nullptr)
+                throw cRuntimeError("OSPF snapshot contains unknown interface %d in area %s", ifIndex, areaId.str(false).c_str());
+
+            uint32_t neighborCount = stream.readUint32Be();
+            for (uint32_t k = 0; k < neighborCount; k++) {
+                RouterId neighborID = stream.readIpv4Address();
+                Ipv4Address neighborAddress = stream.readIpv4Address();
+                Neighbor *neighbor = intf->getNeighborById(neighborID);
+                if (neighbor == nullptr) {
+                    neighbor = new Neighbor(neighborID);
+                    neighbor->setAddress(neighborAddress);
+                    intf->addNeighbor(neighbor);
+                }
+                neighbor->setPriority(stream.readByte());
+                Ospfv2Options options;
+                Ospfv2PacketSerializer::deserializeOspfOptions(stream, options);
+                neighbor->setOptions(options);
+                DesignatedRouterId designatedRouter;
+                designatedRouter.routerID = stream.readIpv4Address();
+                designatedRouter.ipInterfaceAddress = stream.readIpv4Address();
+                neighbor->setDesignatedRouter(designatedRouter);
+                DesignatedRouterId backupDesignatedRouter;
+                backupDesignatedRouter.routerID = stream.readIpv4Address();
+                backupDesignatedRouter.ipInterfaceAddress = stream.readIpv4Address();
+                neighbor->setBackupDesignatedRouter(backupDesignatedRouter);
+                neighbor->setRouterDeadInterval(stream.readUint16Be());
+                neighbor->restoreFullState();
+            }
+        }
+    }
+
+    uint32_t externalLsaCount = stream.readUint32Be();
+    for (uint32_t i = 0; i < externalLsaCount; i++)
+        readAndInstallLsa(stream, router, BACKBONE_AREAID);
+
+    if (stream.isReadBeyondEnd())
+        throw cRuntimeError("Truncated router state in OSPF snapshot");
+}
+
+void Ospfv2Snapshot::save(const char *fileName, const char *routerPath, Router *router)
+{
+    MemoryOutputStream stream;
+    writeRouter(stream, router);
+    Ospfv2SnapshotFiles::getInstance().addRecord(fileName, routerPath) = stream.getData();
+}
+
+void Ospfv2Snapshot::restore(const char *fileName, const char *routerPath, Router *router)
+{
+    MemoryInputStream stream(Ospfv2SnapshotFiles::getInstance().getRecord(fileName, routerPath));
+    readRouter(stream, router);
+    router->rebuildRoutingTable();
+}
+
+} // namespace ospfv2
+} // namespace inet
+
@@ -0,0 +1,53 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#ifndef __INET_OSPFV2SNAPSHOT_H
+#define __INET_OSPFV2SNAPSHOT_H
+
+#include "inet/common/MemoryInputStream.h"
+#include "inet/common/MemoryOutputStream.h"
+#include "inet/routing/ospfv2/router/Ospfv2Router.h"
+
+namespace inet {
+
+namespace ospfv2 {
+
+/**
+ * Saves the converged state of Ospfv2 routers into a binary snapshot file and
+ * restores it in a later run, so that the run does not have to simulate the
+ * initial adjacency formation and flooding.
+ *
+ * The snapshot of a router contains its link state databases and its
+ * adjacencies in FULL state. The routing table (and the routes installed into
+ * the IP routing table) is not stored, it is recalculated from the restored
+ * databases. The records of all routers are collected in memory and written
+ * into the file when the network finishes; a file is read only once per run.
+ */
+class INET_API Ospfv2Snapshot
+{
+  private:
+    static void writeLsa(MemoryOutputStream& stream, const Ospfv2Lsa& lsa);
+    static void readAndInstallLsa(MemoryInputStream& stream, Router *router, AreaId areaID);
+    static void writeRouter(MemoryOutputStream& stream, Router *router);
+    static void readRouter(MemoryInputStream& stream, Router *router);
+
+  public:
+    /**
+     * Records the state of the router under routerPath into the snapshot file.
+     */
+    static void save(const char *fileName, const char *routerPath, Router *router);
+
+    /**
+     * Restores the state recorded under routerPath from the snapshot file. The
+     * router must have been configured from the same OSPF configuration.
+     */
+    static void restore(const char *fileName, const char *routerPath, Router *router);
+};
+
+} // namespace ospfv2
+
+} // namespace inet
+
+#endif
+
@@ -0,0 +1,322 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#include "inet/routing/ospfv2/benchmark/Ospfv2Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+
+#include "inet/networklayer/ipv4/Ipv4InterfaceData.h"
+#include "inet/routing/ospfv2/Ospfv2Crc.h"
+#include "inet/routing/ospfv2/interface/Ospfv2Interface.h"
+#include "inet/routing/ospfv2/router/Ospfv2Area.h"
+
+namespace inet {
+
+namespace ospfv2 {
+
+Define_Module(Ospfv2Benchmark);
+
+namespace {
+
+typedef std::chrono::steady_clock BenchmarkClock;
+
+double secondsSince(BenchmarkClock::time_point start)
+{
+    return std::chrono::duration<double>(BenchmarkClock::now() - start).count();
+}
+
+} // namespace
+
+Ospfv2Benchmark::~Ospfv2Benchmark()
+{
+    cancelAndDelete(benchmarkTimer);
+}
+
+void Ospfv2Benchmark::initialize(int stage)
+{
+    if (stage == INITSTAGE_LOCAL) {
+        interfaceTable.reference(this, "interfaceTableModule", true);
+        routingTable.reference(this, "routingTableModule", true);
+        rootPosition = GridPosition(par("rootSatellite"), par("rootOrbit"));
+        linkCost = par("linkCost");
+        crcMode = parseCrcMode(par("crcMode"), false);
+        if (rootPosition.first < 1 || rootPosition.first > SQSQ_N || rootPosition.second < 1 || rootPosition.second > SQSQ_M)
+            throw cRuntimeError("The root satellite must be in the %d x %d grid of the satellite network", SQSQ_N, SQSQ_M);
+        benchmarkTimer = new cMessage("benchmark");
+        scheduleAt(par("benchmarkTime"), benchmarkTimer);
+    }
+    else if (stage == INITSTAGE_NETWORK_ADDRESS_ASSIGNMENT)
+        configureInterfaces();
+}
+
+void Ospfv2Benchmark::handleMessage(cMessage *msg)
+{
+    if (msg == benchmarkTimer)
+        runBenchmark();
+    else
+        throw cRuntimeError("Unknown message");
+}
+
+RouterId Ospfv2Benchmark::getRouterId(const GridPosition& position) const
+{
+    // the same router IDs as in the satellite network, see getDirection()
+    return RouterId(0, 0, position.first, position.second);
+}
+
+std::vector<Ospfv2Benchmark::GridPosition> Ospfv2Benchmark::getNeighbors(const GridPosition& position) const
+{
+    // in the order of the directions of getDirection()
+    int x = position.first, y = position.second;
+    return {
+        GridPosition(sqsqRescaleN(x - 1), y),
+        GridPosition(sqsqRescaleN(x + 1), y),
+        GridPosition(x, sqsqRescaleM(y - 1)),
+        GridPosition(x, sqsqRescaleM(y + 1))
+    };
+}
+
+int Ospfv2Benchmark::getLinkIndex(const GridPosition& position, int direction) const
+{
+    // every satellite owns the links in directions 1 and 3, the others belong to the neighbors
+    GridPosition owner = (direction == 0 || direction == 2) ? getNeighbors(position)[direction] : position;
+    int ownerIndex = (owner.second - 1) * SQSQ_N + owner.first - 1;
+    return 2 * ownerIndex + (direction < 2 ? 0 : 1);
+}
+
+Ipv4Address Ospfv2Benchmark::getInterfaceAddress(const GridPosition& position, int direction) const
+{
+    // installRouterLSA() restores the failed links with the same addresses
+    auto it = InterfaceAddressesByRouterID.find(getRouterId(position));
+    if (it == InterfaceAddressesByRouterID.end())
+        throw cRuntimeError("No interface addresses for satellite %s", getRouterId(position).str(false).c_str());
+    return it->second[direction];
+}
+
+void Ospfv2Benchmark::configureInterfaces()
+{
+    // the inter-satellite links of the root, named eth<direction> as in the satellite network
+    for (int direction = 0; direction < 4; direction++) {
+        std::string name = "eth" + std::to_string(direction);
+        NetworkInterface *networkInterface = interfaceTable->findInterfaceByName(name.c_str());
+        if (networkInterface == nullptr)
+            throw cRuntimeError("Interface '%s' not found", name.c_str());
+        auto interfaceData = networkInterface->addProtocolData<Ipv4InterfaceData>();
+        interfaceData->setIPAddress(getInterfaceAddress(rootPosition, direction));
+        interfaceData->setNetmask(Ipv4Address(255, 255, 255, 252));
+    }
+}
+
+Router *Ospfv2Benchmark::createRouter()
+{
+    routingTable->setRouterId(getRouterId(rootPosition));
+    Router *router = new Router(this, interfaceTable.get(), routingTable.get());
+    Ospfv2Area *area = new Ospfv2Area(crcMode, interfaceTable.get(), BACKBONE_AREAID);
+    router->addArea(area);
+    for (int direction = 0; direction < 4; direction++) {
+        NetworkInterface *networkInterface = interfaceTable->findInterfaceByName(("eth" + std::to_string(direction)).c_str());
+        // the interfaces stay down, no packets are exchanged; the routing table calculation only needs their addresses
+        Ospfv2Interface *intf = new Ospfv2Interface;
+        intf->setInterfaceName(networkInterface->getInterfaceName());
+        intf->setAreaId(BACKBONE_AREAID);
+        intf->setIfIndex(interfaceTable.get(), networkInterface->getInterfaceId()); // should be called before calling setType()
+        intf->setType(Ospfv2Interface::POINTTOPOINT);
+        intf->setCrcMode(crcMode);
+        intf->setOutputCost(linkCost);
+        area->addInterface(intf);
+    }
+    return router;
+}
+
+RouterLsa *Ospfv2Benchmark::createRouterLsa(const GridPosition& position, const std::vector<int>& linkPerturbations, long sequenceNumber) const
+{
+    RouterLsa *routerLsa = new RouterLsa;
+    Ospfv2LsaHeader& lsaHeader = routerLsa->getHeaderForUpdate();
+    RouterId routerId = getRouterId(position);
+    lsaHeader.setLsAge(0);
+    lsaHeader.setLsType(ROUTERLSA_TYPE);
+    lsaHeader.setLinkStateID(routerId);
+    lsaHeader.setAdvertisingRouter(routerId);
+    lsaHeader.setLsSequenceNumber(sequenceNumber);
+
+    // the links of Ospfv2Area::originateRouterLSA(); a failed link is left out with its stub, like a link of a down interface
+    std::vector<GridPosition> neighbors = getNeighbors(position);
+    std::vector<Ospfv2Link> links;
+    for (int direction = 0; direction < 4; direction++) {
+        int perturbation = linkPerturbations[getLinkIndex(position, direction)];
+        if (perturbation < 0)
+            continue;
+        Ipv4Address interfaceAddress = getInterfaceAddress(position, direction);
+        Metric cost = std::min(linkCost + perturbation, 0xFFFF);
+
+        Ospfv2Link link;
+        link.setType(POINTTOPOINT_LINK);
+        link.setLinkID(Ipv4Address(getRouterId(neighbors[direction])));
+        link.setLinkData(interfaceAddress.getInt());
+        link.setLinkCost(cost);
+        link.setNumberOfTOS(0);
+        link.setTosDataArraySize(0);
+        links.push_back(link);
+
+        Ospfv2Link stubLink;
+        stubLink.setType(STUB_LINK);
+        stubLink.setLinkID(getNeighboringInterfaceAddr(interfaceAddress));
+        stubLink.setLinkData(0xFFFFFFFF);
+        stubLink.setLinkCost(cost);
+        stubLink.setNumberOfTOS(0);
+        stubLink.setTosDataArraySize(0);
+        links.push_back(stubLink);
+    }
+    routerLsa->setNumberOfLinks(links.size());
+    routerLsa->setLinksArraySize(links.size());
+    for (size_t i = 0; i < links.size(); i++)
+        routerLsa->setLinks(i, links[i]);
+
+    lsaHeader.setLsaLength(calculateLSASize(routerLsa).get());
+    setLsaCrc(*routerLsa, crcMode);
+    return routerLsa;
+}
+
+void Ospfv2Benchmark::runBenchmark()
+{
+    Router *router = createRouter();
+    Ospfv2Area *area = router->getAreaByID(BACKBONE_AREAID);
+
+    std::vector<GridPosition> positions;
+    for (int y = 1; y <= SQSQ_M; y++)
+        for (int x = 1; x <= SQSQ_N; x++)
+            positions.push_back(GridPosition(x, y));
+    int linkCount = 2 * positions.size();
+    std::vector<int> unperturbedLinks(linkCount, 0);
+    for (auto& position : positions) {
+        RouterLsa *lsa = createRouterLsa(position, unperturbedLinks, INITIAL_SEQUENCE_NUMBER);
+        area->installRouterLSA(lsa);
+        delete lsa;
+    }
+    router->rebuildRoutingTable();
+
+    // the lookups cover the addresses of all inter-satellite links, and the same number of random addresses
+    std::vector<Ipv4Address> destinations;
+    for (auto& position : positions)
+        for (int direction = 0; direction < 4; direction++)
+            destinations.push_back(getInterfaceAddress(position, direction));
+    for (size_t i = 0, n = destinations.size(); i < n; i++)
+        destinations.push_back(Ipv4Address((uint32_t)intuniform(0, 0xFFFF) << 16 | intuniform(0, 0xFFFF)));
+
+    double linkFailureProbability = par("linkFailureProbability");
+    int maxCostIncrease = par("maxCostIncrease");
+    int repetitions = par("repetitions");
+    Measurement install{"installRouterLSA", (long)positions.size()};
+    Measurement spf{"calculateShortestPathTree"};
+    Measurement rebuild{"rebuildRoutingTable"};
+    Measurement lookup{"findBestMatchingRoute", (long)destinations.size()};
+
+    for (int repetition = 0; repetition < repetitions; repetition++) {
+        // both ends of a link get the same perturbation: -1 means failed, otherwise the cost increase
+        std::vector<int> linkPerturbations(linkCount);
+        int failedLinks = 0;
+        for (auto& perturbation : linkPerturbations) {
+            perturbation = bernoulli(linkFailureProbability) ? -1 : intuniform(0, maxCostIncrease);
+            if (perturbation < 0)
+                failedLinks++;
+        }
+        std::vector<RouterLsa *> perturbedLsas;
+        for (auto& position : positions)
+            perturbedLsas.push_back(createRouterLsa(position, linkPerturbations, INITIAL_SEQUENCE_NUMBER + repetition + 1));
+
+        auto start = BenchmarkClock::now();
+        for (auto lsa : perturbedLsas)
+            area->installRouterLSA(lsa);
+        install.durations.push_back(secondsSince(start));
+
+        // the per-direction calculation of the satellite network, without installing the result
+        std::vector<Ospfv2RoutingTableEntry *> table;
+        start = BenchmarkClock::now();
+        area->calculateShortestPathTree(table);
+        spf.durations.push_back(secondsSince(start));
+        size_t routeCount = table.size();
+        router->getRoutingTableEntryPool().releaseAll(table);
+
+        // the same calculation again, then the difference to the previous repetition is applied to the Ipv4 routing table
+        start = BenchmarkClock::now();
+        router->rebuildRoutingTable();
+        rebuild.durations.push_back(secondsSince(start));
+
+        int matchCount = 0;
+        start = BenchmarkClock::now();
+        for (auto& destination : destinations)
+            if (routingTable->findBestMatchingRoute(destination) != nullptr)
+                matchCount++;
+        lookup.durations.push_back(secondsSince(start));
+
+        EV_DETAIL << "Benchmark repetition " << repetition << ": " << failedLinks << " of " << linkCount << " links failed, "
+                  << routeCount << " OSPF routes, " << matchCount << " of " << destinations.size() << " lookups matched" << endl;
+
+        for (auto lsa : perturbedLsas)
+            delete lsa;
+    }
+
+    unsigned long lsdbSize = router->getLsdbSize();
+    unsigned long routeCount = routingTable->getNumRoutes();
+    delete router;
+    writeResults({install, spf, rebuild, lookup}, lsdbSize, routeCount);
+}
+
+void Ospfv2Benchmark::writeResults(const std::vector<Measurement>& measurements, unsigned long lsdbSize, unsigned long routeCount)
+{
+    // the layout follows the JSON output of Google Benchmark, so that the usual comparison tools can be used
+    const char *fileName = par("resultFile");
+    std::ofstream file(fileName, std::ios::trunc);
+    file << "{\n";
+    file << "  \"context\": {\n";
+    file << "    \"orbits\": " << SQSQ_M << ",\n";
+    file << "    \"satellitesPerOrbit\": " << SQSQ_N << ",\n";
+    file << "    \"loopAvoidance\": " << (LOOP_AVOIDANCE ? "true" : "false") << ",\n";
+    file << "    \"linkCost\": " << linkCost << ",\n";
+    file << "    \"lsdbSize\": " << lsdbSize << ",\n";
+    file << "    \"ipv4RouteCount\": " << routeCount << ",\n";
+    file << "    \"linkFailureProbability\": " << par("linkFailureProbability").doubleValue() << ",\n";
+    file << "    \"maxCostIncrease\": " << par("maxCostIncrease").intValue() << ",\n";
+    file << "    \"seedset\": " << getEnvir()->getConfigEx()->getVariable(CFGVAR_SEEDSET) << "\n";
+    file << "  },\n";
+    file << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < measurements.size(); i++) {
+        const Measurement& measurement = measurements[i];
+        std::vector<double> durations = measurement.durations;
+        std::sort(durations.begin(), durations.end());
+        double sum = 0;
+        for (double duration : durations)
+            sum += duration;
+        double mean = durations.empty() ? 0 : sum / durations.size();
+        double variance = 0;
+        for (double duration : durations)
+            variance += (duration - mean) * (duration - mean);
+        double stddev = durations.size() > 1 ? std::sqrt(variance / (durations.size() - 1)) : 0;
+        double median = durations.empty() ? 0 : durations[durations.size() / 2];
+
+        file << "    {\n";
+        file << "      \"name\": \"" << measurement.name << "\",\n";
+        file << "      \"iterations\": " << durations.size() << ",\n";
+        file << "      \"items_per_iteration\": " << measurement.itemsPerRun << ",\n";
+        file << "      \"real_time\": " << mean * 1e6 << ",\n";
+        file << "      \"median_time\": " << median * 1e6 << ",\n";
+        file << "      \"min_time\": " << (durations.empty() ? 0 : durations.front() * 1e6) << ",\n";
+        file << "      \"max_time\": " << (durations.empty() ? 0 : durations.back() * 1e6) << ",\n";
+        file << "      \"stddev_time\": " << stddev * 1e6 << ",\n";
+        file << "      \"time_per_item\": " << (measurement.itemsPerRun > 0 ? mean * 1e6 / measurement.itemsPerRun : 0) << ",\n";
+        file << "      \"time_unit\": \"us\"\n";
+        file << "    }" << (i + 1 < measurements.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n";
+    file << "}\n";
+    if (!file)
+        throw cRuntimeError("Cannot write benchmark results into '%s'", fileName);
+    EV_INFO << "Benchmark results written into " << fileName << endl;
+}
+
+} // namespace ospfv2
+
+} // namespace inet
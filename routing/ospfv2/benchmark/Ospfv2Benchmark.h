@@ -0,0 +1,79 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#ifndef __INET_OSPFV2BENCHMARK_H
+#define __INET_OSPFV2BENCHMARK_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "inet/common/ModuleRefByPar.h"
+#include "inet/networklayer/contract/IInterfaceTable.h"
+#include "inet/networklayer/ipv4/IIpv4RoutingTable.h"
+#include "inet/routing/ospfv2/router/Ospfv2Router.h"
+
+namespace inet {
+
+namespace ospfv2 {
+
+/**
+ * Micro-benchmark of the satellite OSPF algorithms. It runs without any
+ * Ospfv2 module: it creates an OSPF Router of its own on top of the
+ * interface table and the IPv4 routing table of the containing
+ * Ospfv2BenchmarkNode, with one point-to-point interface per direction, and
+ * builds the LSDB of the Walker grid of the satellite network (SQSQ_M orbits
+ * of SQSQ_N satellites, with the interface addresses of Ospfv2Common.h)
+ * directly from the parameters.
+ *
+ * In every repetition it creates a perturbed copy of the LSDB (random link
+ * failures and cost increases), then times installing it with
+ * Ospfv2Area::installRouterLSA() (with the loop avoidance, if enabled),
+ * the per-direction shortest path calculation, the routing table rebuild
+ * that installs the difference into the IPv4 routing table, and longest
+ * prefix match lookups in the IPv4 routing table. The results are written
+ * into a JSON file.
+ */
+class INET_API Ospfv2Benchmark : public cSimpleModule
+{
+  protected:
+    typedef std::pair<int, int> GridPosition; // satellite in orbit (1..SQSQ_N), orbit (1..SQSQ_M)
+
+    struct Measurement {
+        std::string name;
+        long itemsPerRun = 1; // e.g. number of LSAs installed in one timed run
+        std::vector<double> durations; // wall-clock duration of the timed runs [s]
+    };
+
+    ModuleRefByPar<IInterfaceTable> interfaceTable;
+    ModuleRefByPar<IIpv4RoutingTable> routingTable;
+    cMessage *benchmarkTimer = nullptr;
+    GridPosition rootPosition;
+    int linkCost = -1;
+    CrcMode crcMode = CRC_DECLARED_CORRECT; // of the LSAs
+
+  protected:
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void initialize(int stage) override;
+    virtual void handleMessage(cMessage *msg) override;
+
+    virtual void configureInterfaces();
+    virtual Router *createRouter();
+    virtual void runBenchmark();
+    virtual RouterId getRouterId(const GridPosition& position) const;
+    virtual std::vector<GridPosition> getNeighbors(const GridPosition& position) const;
+    virtual int getLinkIndex(const GridPosition& position, int direction) const;
+    virtual Ipv4Address getInterfaceAddress(const GridPosition& position, int direction) const;
+    virtual RouterLsa *createRouterLsa(const GridPosition& position, const std::vector<int>& linkPerturbations, long sequenceNumber) const;
+    virtual void writeResults(const std::vector<Measurement>& measurements, unsigned long lsdbSize, unsigned long routeCount);
+
+  public:
+    virtual ~Ospfv2Benchmark();
+};
+
+} // namespace ospfv2
+
+} // namespace inet
+
+#endif
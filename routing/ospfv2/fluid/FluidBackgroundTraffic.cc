@@ -0,0 +1,256 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#include "inet/routing/ospfv2/fluid/FluidBackgroundTraffic.h"
+
+#include "inet/common/Topology.h"
+#include "inet/networklayer/common/L3AddressResolver.h"
+#include "inet/networklayer/ipv4/Ipv4InterfaceData.h"
+
+namespace inet {
+
+namespace ospfv2 {
+
+Define_Module(FluidBackgroundTraffic);
+
+simsignal_t FluidBackgroundTraffic::offeredRateSignal = registerSignal("offeredRate");
+simsignal_t FluidBackgroundTraffic::deliveredRateSignal = registerSignal("deliveredRate");
+
+FluidBackgroundTraffic::~FluidBackgroundTraffic()
+{
+    cancelAndDelete(updateTimer);
+}
+
+void FluidBackgroundTraffic::initialize(int stage)
+{
+    if (stage == INITSTAGE_LOCAL) {
+        if (getEnvir()->getParsimNumPartitions() > 1)
+            throw cRuntimeError("The fluid background traffic needs all routing tables and queues in one process, it cannot be used with parallel simulation");
+        updateInterval = par("updateInterval");
+        stopTime = par("stopTime");
+        if (updateInterval <= 0)
+            throw cRuntimeError("The updateInterval parameter must be positive");
+        updateTimer = new cMessage("update");
+        scheduleAt(par("startTime"), updateTimer);
+    }
+}
+
+void FluidBackgroundTraffic::handleMessage(cMessage *msg)
+{
+    if (msg == updateTimer) {
+        if (!topologyExtracted) {
+            extractTopology();
+            addDemands();
+        }
+        bool stopped = stopTime >= 0 && simTime() >= stopTime;
+        if (stopped)
+            demandsByDestination.clear();
+        updateRates();
+        if (!stopped)
+            scheduleAfter(updateInterval, updateTimer);
+    }
+    else
+        throw cRuntimeError("Unknown message");
+}
+
+void FluidBackgroundTraffic::extractTopology()
+{
+    Topology topology;
+    topology.extractByProperty("networkNode");
+
+    L3AddressResolver addressResolver;
+    std::map<int, int> nodeIndexByModuleId;
+    for (int i = 0; i < topology.getNumNodes(); i++) {
+        cModule *module = topology.getNode(i)->getModule();
+        Node node;
+        node.module = module;
+        node.routingTable = addressResolver.findIpv4RoutingTableOf(module);
+        node.interfaceTable = addressResolver.findInterfaceTableOf(module);
+        if (node.routingTable == nullptr || node.interfaceTable == nullptr)
+            continue;
+        nodeIndexByModuleId[module->getId()] = nodes.size();
+        nodes.push_back(node);
+    }
+
+    // the first non-loopback address of a node is used as its destination,
+    // and the fluid is queued in the PacketQueue of the output interfaces
+    destinations.resize(nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        IInterfaceTable *ift = nodes[i].interfaceTable;
+        for (int j = 0; j < ift->getNumInterfaces(); j++) {
+            NetworkInterface *ie = ift->getInterface(j);
+            auto ipv4Data = ie->findProtocolData<Ipv4InterfaceData>();
+            if (ipv4Data != nullptr && !ipv4Data->getIPAddress().isUnspecified()) {
+                nodeIndexByAddress[ipv4Data->getIPAddress()] = i;
+                if (!ie->isLoopback() && destinations[i].isUnspecified())
+                    destinations[i] = ipv4Data->getIPAddress();
+            }
+            auto queue = dynamic_cast<queueing::PacketQueue *>(ie->getSubmodule("queue"));
+            if (queue != nullptr) {
+                nodes[i].queueByInterfaceId[ie->getInterfaceId()] = queues.size();
+                queues.push_back({queue, ie, 1});
+            }
+        }
+    }
+
+    // routes without a gateway on point-to-point links are resolved by the link itself
+    for (int i = 0; i < topology.getNumNodes(); i++) {
+        Topology::Node *topologyNode = topology.getNode(i);
+        auto it = nodeIndexByModuleId.find(topologyNode->getModuleId());
+        if (it == nodeIndexByModuleId.end())
+            continue;
+        Node& node = nodes[it->second];
+        for (int j = 0; j < topologyNode->getNumOutLinks(); j++) {
+            Topology::Link *link = topologyNode->getLinkOut(j);
+            auto peerIt = nodeIndexByModuleId.find(link->getLinkOutRemoteNode()->getModuleId());
+            NetworkInterface *ie = node.interfaceTable->findInterfaceByNodeOutputGateId(link->getLinkOutLocalGateId());
+            if (peerIt != nodeIndexByModuleId.end() && ie != nullptr && ie->isPointToPoint())
+                node.peerByInterfaceId[ie->getInterfaceId()] = peerIt->second;
+        }
+    }
+    topologyExtracted = true;
+    EV_INFO << "Fluid background traffic over " << nodes.size() << " nodes and " << queues.size() << " queues" << endl;
+}
+
+void FluidBackgroundTraffic::addDemands()
+{
+    double uniformRate = par("uniformRate").doubleValueInUnit("bps");
+    if (uniformRate > 0) {
+        for (size_t i = 0; i < nodes.size(); i++)
+            for (size_t j = 0; j < nodes.size(); j++)
+                if (i != j && !destinations[j].isUnspecified())
+                    demandsByDestination[j].push_back({(int)i, (int)j, uniformRate});
+    }
+
+    cValueArray *demandConfigurations = check_and_cast<cValueArray *>(par("demands").objectValue());
+    for (int i = 0; i < demandConfigurations->size(); i++) {
+        cValueMap *demandConfiguration = check_and_cast<cValueMap *>(demandConfigurations->get(i).objectValue());
+        Demand demand;
+        demand.source = findNodeIndex(demandConfiguration->get("source").stringValue());
+        demand.destination = findNodeIndex(demandConfiguration->get("destination").stringValue());
+        demand.rate = demandConfiguration->get("rate").doubleValueInUnit("bps");
+        if (destinations[demand.destination].isUnspecified())
+            throw cRuntimeError("The destination of demand %d has no IPv4 address", i);
+        demandsByDestination[demand.destination].push_back(demand);
+    }
+}
+
+int FluidBackgroundTraffic::findNodeIndex(const char *path) const
+{
+    cModule *module = getSimulation()->getSystemModule()->getModuleByPath((std::string(".") + path).c_str());
+    for (size_t i = 0; i < nodes.size(); i++)
+        if (nodes[i].module == module)
+            return i;
+    throw cRuntimeError("Network node '%s' not found", path);
+}
+
+int FluidBackgroundTraffic::getNextHop(int nodeIndex, int destinationIndex, int& queueIndex) const
+{
+    queueIndex = -1;
+    const Node& node = nodes[nodeIndex];
+    const Ipv4Route *route = node.routingTable->findBestMatchingRoute(destinations[destinationIndex]);
+    if (route == nullptr)
+        return -1;
+    const NetworkInterface *ie = route->getInterface();
+    if (ie == nullptr || ie->isLoopback() || !ie->isUp())
+        return -1;
+    auto queueIt = node.queueByInterfaceId.find(ie->getInterfaceId());
+    if (queueIt != node.queueByInterfaceId.end())
+        queueIndex = queueIt->second;
+    Ipv4Address nextHopAddress = route->getGateway();
+    if (!nextHopAddress.isUnspecified()) {
+        auto it = nodeIndexByAddress.find(nextHopAddress);
+        return it != nodeIndexByAddress.end() ? it->second : -1;
+    }
+    auto it = node.peerByInterfaceId.find(ie->getInterfaceId());
+    if (it != node.peerByInterfaceId.end())
+        return it->second;
+    // directly connected multi-access network
+    return destinationIndex;
+}
+
+void FluidBackgroundTraffic::updateRates()
+{
+    // every demand is thinned by the delivery ratio of the queues it has crossed,
+    // taken from the previous update, so the rates of overloaded paths settle over a few updates
+    std::vector<double> arrivalRates(queues.size(), 0);
+    double offeredRate = 0;
+    double deliveredRate = 0;
+    for (auto& elem : demandsByDestination) {
+        for (auto& demand : elem.second)
+            offeredRate += demand.rate;
+        routeDemands(elem.first, elem.second, arrivalRates, deliveredRate);
+    }
+
+    for (size_t i = 0; i < queues.size(); i++) {
+        Queue& queue = queues[i];
+        double serviceRate = queue.networkInterface->isUp() ? queue.networkInterface->getDatarate() : 0;
+        queue.queue->setFluidRates(arrivalRates[i], serviceRate);
+        queue.deliveryRatio = queue.queue->getFluidDeliveryRatio();
+    }
+    emit(offeredRateSignal, offeredRate);
+    emit(deliveredRateSignal, deliveredRate);
+}
+
+void FluidBackgroundTraffic::routeDemands(int destination, const std::vector<Demand>& demands, std::vector<double>& arrivalRates, double& deliveredRate)
+{
+    // the next hops towards the destination form trees that end at the destination, at a black hole or in a forwarding loop
+    std::vector<double> rates(nodes.size(), 0); // the sum of the rates leaving the node
+    std::vector<int> nextHops(nodes.size(), -1);
+    std::vector<int> queueIndices(nodes.size(), -1);
+    std::vector<int> upstreamCounts(nodes.size(), 0); // nodes whose rates have not been added yet
+    for (auto& demand : demands)
+        rates[demand.source] += demand.rate;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if ((int)i != destination) {
+            nextHops[i] = getNextHop(i, destination, queueIndices[i]);
+            if (nextHops[i] >= 0)
+                upstreamCounts[nextHops[i]]++;
+        }
+    }
+
+    // a node passes its rate on when all its upstream nodes are done
+    std::vector<int> readyNodes;
+    for (size_t i = 0; i < nodes.size(); i++)
+        if (upstreamCounts[i] == 0)
+            readyNodes.push_back(i);
+    while (!readyNodes.empty()) {
+        int current = readyNodes.back();
+        readyNodes.pop_back();
+        int next = nextHops[current];
+        if (next < 0)
+            continue; // destination or black hole
+        double rate = rates[current];
+        int queueIndex = queueIndices[current];
+        if (queueIndex >= 0) {
+            arrivalRates[queueIndex] += rate;
+            rate *= queues[queueIndex].deliveryRatio;
+        }
+        rates[next] += rate;
+        if (--upstreamCounts[next] == 0)
+            readyNodes.push_back(next);
+    }
+    deliveredRate += rates[destination];
+
+    // the nodes left are on forwarding loops, each loop gets the rate of all its nodes once
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (upstreamCounts[i] == 0)
+            continue;
+        std::vector<int> loop;
+        double loopRate = 0;
+        for (int current = i; upstreamCounts[current] != 0; current = nextHops[current]) {
+            upstreamCounts[current] = 0;
+            loop.push_back(current);
+            loopRate += rates[current];
+        }
+        for (int current : loop)
+            if (queueIndices[current] >= 0)
+                arrivalRates[queueIndices[current]] += loopRate;
+    }
+}
+
+} // namespace ospfv2
+
+} // namespace inet
+
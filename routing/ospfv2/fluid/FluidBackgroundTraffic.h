@@ -0,0 +1,90 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#ifndef __INET_FLUIDBACKGROUNDTRAFFIC_H
+#define __INET_FLUIDBACKGROUNDTRAFFIC_H
+
+#include <map>
+#include <vector>
+
+#include "inet/networklayer/contract/IInterfaceTable.h"
+#include "inet/networklayer/ipv4/IIpv4RoutingTable.h"
+#include "inet/queueing/queue/PacketQueue.h"
+
+namespace inet {
+
+namespace ospfv2 {
+
+/**
+ * Background traffic modeled as fluid rates. The demands are routed along the
+ * current IP routing tables, and their sum is set as the arrival rate of the
+ * output queues they cross, which integrate their backlog from the rates.
+ * The demands to a destination are aggregated: every node is looked up once
+ * per destination, and the rates are pushed down the next hops in
+ * topological order.
+ *
+ * See the NED file for details.
+ */
+class INET_API FluidBackgroundTraffic : public cSimpleModule
+{
+  protected:
+    struct Node {
+        cModule *module = nullptr;
+        IIpv4RoutingTable *routingTable = nullptr;
+        IInterfaceTable *interfaceTable = nullptr;
+        std::map<int, int> peerByInterfaceId; // point-to-point interface id -> index of the node on the other end
+        std::map<int, int> queueByInterfaceId; // interface id -> index into queues
+    };
+
+    struct Demand {
+        int source = -1;
+        int destination = -1;
+        double rate = 0; // [bps]
+    };
+
+    struct Queue {
+        queueing::PacketQueue *queue = nullptr;
+        NetworkInterface *networkInterface = nullptr;
+        double deliveryRatio = 1; // of the previous update
+    };
+
+    // configuration
+    simtime_t updateInterval;
+    simtime_t stopTime;
+
+    // state
+    bool topologyExtracted = false;
+    std::vector<Node> nodes;
+    std::map<Ipv4Address, int> nodeIndexByAddress;
+    std::vector<Ipv4Address> destinations; // one address of each node, the index is the node index
+    std::vector<Queue> queues;
+    std::map<int, std::vector<Demand>> demandsByDestination; // destination node index -> demands, they are routed together
+    cMessage *updateTimer = nullptr;
+
+    // statistics
+    static simsignal_t offeredRateSignal;
+    static simsignal_t deliveredRateSignal;
+
+  protected:
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void initialize(int stage) override;
+    virtual void handleMessage(cMessage *msg) override;
+
+    virtual void extractTopology();
+    virtual void addDemands();
+    virtual int findNodeIndex(const char *path) const;
+    virtual int getNextHop(int nodeIndex, int destinationIndex, int& queueIndex) const;
+    virtual void updateRates();
+    virtual void routeDemands(int destination, const std::vector<Demand>& demands, std::vector<double>& arrivalRates, double& deliveredRate);
+
+  public:
+    virtual ~FluidBackgroundTraffic();
+};
+
+} // namespace ospfv2
+
+} // namespace inet
+
+#endif
+
@@ -51,8 +51,8 @@ Ospfv2Interface::Ospfv2Interface(Ospfv2Interface::Ospfv2InterfaceType ifType) :
     authenticationType(NULL_TYPE),
     parentArea(nullptr)
 {
-    state = new InterfaceStateDown;
-    previousState = nullptr;
+    state = InterfaceStateDown::getInstance();
+    previousState = DOWN_STATE;
     helloTimer = new cMessage("Interface::InterfaceHelloTimer", INTERFACE_HELLO_TIMER);
     helloTimer->setContextPointer(this);
     waitTimer = new cMessage("Interface::InterfaceWaitTimer", INTERFACE_WAIT_TIMER);
@@ -73,9 +73,6 @@ Ospfv2Interface::~Ospfv2Interface()
     delete helloTimer;
     delete waitTimer;
     delete acknowledgementTimer;
-    if (previousState)
-        delete previousState;
-    delete state;
     for (uint32_t i = 0; i < neighboringRouters.size(); i++)
         delete neighboringRouters[i];
 }
@@ -144,11 +141,8 @@ void Ospfv2Interface::changeState(Ospfv2InterfaceState *newState, Ospfv2Interfac
             << " from '" << getStateString(currentState->getState())
             << "' to '" << getStateString(newState->getState()) << "'" << std::endl;
 
-    if (previousState != nullptr) {
-        delete previousState;
-    }
     state = newState;
-    previousState = currentState;
+    previousState = currentState->getState();
 }
 
 void Ospfv2Interface::processEvent(Ospfv2Interface::Ospfv2InterfaceEventType event)
@@ -347,7 +341,7 @@ bool Ospfv2Interface::isOnAnyRetransmissionList(LsaKeyType lsaKey) const
 /**
  * @see RFC2328 Section 13.3.
  */
-bool Ospfv2Interface::floodLsa(const Ospfv2Lsa *lsa, int current_ttl /* = -1 */, Ospfv2Interface *intf, Neighbor *neighbor)
+bool Ospfv2Interface::floodLsa(const Ospfv2Lsa *lsa, int current_ttl /* = -1 */, Ospfv2Interface *intf, Neighbor *neighbor, int *fanout)
 {
     /*
      * @sqsq
@@ -417,6 +411,8 @@ bool Ospfv2Interface::floodLsa(const Ospfv2Lsa *lsa, int current_ttl /* = -1 */,
             if (next_ttl >= 1) {
                 neighboringRouters[i]->addToRetransmissionList(lsa); // (1) (d)
                 lsaAddedToRetransmissionList = true;
+                if (fanout != nullptr)
+                    (*fanout)++;
             }
         }
         if (lsaAddedToRetransmissionList) { // (2)
@@ -535,7 +531,9 @@ Packet *Ospfv2Interface::createUpdatePacket(const Ospfv2Lsa *lsa)
             lsaHeader.setLsAge(lsAge);
             auto lsaSize = calculateLSASize(lsa);
             ASSERT(lsaSize == B(lsaHeader.getLsaLength()));
-            setLsaCrc(*lsa, crcMode);
+            // the LS age is not covered by the LS checksum, a valid computed checksum can be kept
+            if (lsaHeader.getLsCrcMode() != crcMode)
+                setLsaCrc(*lsa, crcMode);
             packetLength += lsaSize;
         }
         break;
@@ -68,8 +68,8 @@ class INET_API Ospfv2Interface
     Ospfv2InterfaceType interfaceType;
     Ospfv2InterfaceMode interfaceMode;
     CrcMode crcMode;
-    Ospfv2InterfaceState *state;
-    Ospfv2InterfaceState *previousState;
+    Ospfv2InterfaceState *state; // shared, stateless instance; see Ospfv2InterfaceState
+    Ospfv2InterfaceStateType previousState;
     std::string interfaceName;
     int ifIndex;
     unsigned short mtu;
@@ -120,11 +120,12 @@ class INET_API Ospfv2Interface
     Neighbor *getNeighborByAddress(Ipv4Address address);
     void addNeighbor(Neighbor *neighbor);
     Ospfv2InterfaceStateType getState() const;
+    Ospfv2InterfaceStateType getPreviousState() const { return previousState; }
     static const char *getStateString(Ospfv2InterfaceStateType stateType);
     bool hasAnyNeighborInStates(int states) const;
     void removeFromAllRetransmissionLists(LsaKeyType lsaKey);
     bool isOnAnyRetransmissionList(LsaKeyType lsaKey) const;
-    bool floodLsa(const Ospfv2Lsa *lsa, int current_ttl = -1, Ospfv2Interface *intf = nullptr, Neighbor *neighbor = nullptr);
+    bool floodLsa(const Ospfv2Lsa *lsa, int current_ttl = -1, Ospfv2Interface *intf = nullptr, Neighbor *neighbor = nullptr, int *fanout = nullptr);
     void addDelayedAcknowledgement(const Ospfv2LsaHeader& lsaHeader);
     void sendDelayedAcknowledgements();
     void ageTransmittedLsaLists();
@@ -8,6 +8,7 @@
 
 #include <map>
 
+#include "inet/routing/ospfv2/Ospfv2Crc.h"
 #include "inet/routing/ospfv2/interface/Ospfv2Interface.h"
 #include "inet/routing/ospfv2/interface/Ospfv2InterfaceStateBackup.h"
 #include "inet/routing/ospfv2/interface/Ospfv2InterfaceStateDesignatedRouter.h"
@@ -110,7 +111,7 @@ void Ospfv2InterfaceState::changeState(Ospfv2Interface *intf, Ospfv2InterfaceSta
             else {
                 RouterLsa *newLSA = intf->getArea()->originateRouterLSA();
 
-                newLSA->getHeaderForUpdate().setLsSequenceNumber(sequenceNumber + 1);
+                setLsaSequenceNumber(*newLSA, sequenceNumber + 1);
                 shouldRebuildRoutingTable |= routerLSA->update(newLSA);
                 delete newLSA;
 
@@ -161,7 +162,7 @@ void Ospfv2InterfaceState::changeState(Ospfv2Interface *intf, Ospfv2InterfaceSta
 
 //    shouldRebuildRoutingTable = true;
     if (shouldRebuildRoutingTable) {
-        intf->getArea()->getRouter()->rebuildRoutingTable();
+        intf->getArea()->getRouter()->requestRoutingTableRebuild();
     }
 }
 
@@ -376,37 +377,37 @@ void Ospfv2InterfaceState::calculateDesignatedRouter(Ospfv2Interface *intf)
 
     if (wasBackupDesignatedRouter) {
         if (isDesignatedRouter) {
-            changeState(intf, new InterfaceStateDesignatedRouter, this);
+            changeState(intf, InterfaceStateDesignatedRouter::getInstance(), this);
         }
         if (isOther) {
-            changeState(intf, new InterfaceStateNotDesignatedRouter, this);
+            changeState(intf, InterfaceStateNotDesignatedRouter::getInstance(), this);
         }
     }
     if (wasDesignatedRouter) {
         if (isBackupDesignatedRouter) {
-            changeState(intf, new InterfaceStateBackup, this);
+            changeState(intf, InterfaceStateBackup::getInstance(), this);
         }
         if (isOther) {
-            changeState(intf, new InterfaceStateNotDesignatedRouter, this);
+            changeState(intf, InterfaceStateNotDesignatedRouter::getInstance(), this);
         }
     }
     if (wasOther) {
         if (isDesignatedRouter) {
-            changeState(intf, new InterfaceStateDesignatedRouter, this);
+            changeState(intf, InterfaceStateDesignatedRouter::getInstance(), this);
         }
         if (isBackupDesignatedRouter) {
-            changeState(intf, new InterfaceStateBackup, this);
+            changeState(intf, InterfaceStateBackup::getInstance(), this);
         }
     }
     if (wasWaiting) {
         if (isDesignatedRouter) {
-            changeState(intf, new InterfaceStateDesignatedRouter, this);
+            changeState(intf, InterfaceStateDesignatedRouter::getInstance(), this);
         }
         if (isBackupDesignatedRouter) {
-            changeState(intf, new InterfaceStateBackup, this);
+            changeState(intf, InterfaceStateBackup::getInstance(), this);
         }
         if (isOther) {
-            changeState(intf, new InterfaceStateNotDesignatedRouter, this);
+            changeState(intf, InterfaceStateNotDesignatedRouter::getInstance(), this);
         }
     }
 
@@ -13,6 +13,11 @@ namespace inet {
 
 namespace ospfv2 {
 
+/**
+ * Base class of the interface state machine states. The states carry no data,
+ * every interface refers to the single shared instance of its current state
+ * (see getInstance() of the subclasses), so state transitions do not allocate.
+ */
 class INET_API Ospfv2InterfaceState
 {
   protected:
@@ -16,6 +16,12 @@ namespace inet {
 
 namespace ospfv2 {
 
+InterfaceStateBackup *InterfaceStateBackup::getInstance()
+{
+    static InterfaceStateBackup instance;
+    return &instance;
+}
+
 void InterfaceStateBackup::processEvent(Ospfv2Interface *intf, Ospfv2Interface::Ospfv2InterfaceEventType event)
 {
     if (event == Ospfv2Interface::NEIGHBOR_CHANGE) {
@@ -23,11 +29,11 @@ void InterfaceStateBackup::processEvent(Ospfv2Interface *intf, Ospfv2Interface::
     }
     else if (event == Ospfv2Interface::INTERFACE_DOWN) {
         intf->reset();
-        changeState(intf, new InterfaceStateDown, this);
+        changeState(intf, InterfaceStateDown::getInstance(), this);
     }
     else if (event == Ospfv2Interface::LOOP_INDICATION) {
         intf->reset();
-        changeState(intf, new InterfaceStateLoopback, this);
+        changeState(intf, InterfaceStateLoopback::getInstance(), this);
     }
     else if (event == Ospfv2Interface::HELLO_TIMER) {
         if (intf->getType() == Ospfv2Interface::BROADCAST) {
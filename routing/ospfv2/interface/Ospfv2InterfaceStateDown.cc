@@ -18,6 +18,12 @@ namespace inet {
 
 namespace ospfv2 {
 
+InterfaceStateDown *InterfaceStateDown::getInstance()
+{
+    static InterfaceStateDown instance;
+    return &instance;
+}
+
 void InterfaceStateDown::processEvent(Ospfv2Interface *intf, Ospfv2Interface::Ospfv2InterfaceEventType event)
 {
     if (event == Ospfv2Interface::INTERFACE_UP) {
@@ -28,15 +34,15 @@ void InterfaceStateDown::processEvent(Ospfv2Interface *intf, Ospfv2Interface::Os
             case Ospfv2Interface::POINTTOPOINT:
             case Ospfv2Interface::POINTTOMULTIPOINT:
             case Ospfv2Interface::VIRTUAL:
-                changeState(intf, new InterfaceStatePointToPoint, this);
+                changeState(intf, InterfaceStatePointToPoint::getInstance(), this);
                 break;
 
             case Ospfv2Interface::NBMA:
                 if (intf->getRouterPriority() == 0) {
-                    changeState(intf, new InterfaceStateNotDesignatedRouter, this);
+                    changeState(intf, InterfaceStateNotDesignatedRouter::getInstance(), this);
                 }
                 else {
-                    changeState(intf, new InterfaceStateWaiting, this);
+                    changeState(intf, InterfaceStateWaiting::getInstance(), this);
                     messageHandler->startTimer(intf->getWaitTimer(), intf->getRouterDeadInterval());
 
                     long neighborCount = intf->getNeighborCount();
@@ -51,10 +57,10 @@ void InterfaceStateDown::processEvent(Ospfv2Interface *intf, Ospfv2Interface::Os
 
             case Ospfv2Interface::BROADCAST:
                 if (intf->getRouterPriority() == 0) {
-                    changeState(intf, new InterfaceStateNotDesignatedRouter, this);
+                    changeState(intf, InterfaceStateNotDesignatedRouter::getInstance(), this);
                 }
                 else {
-                    changeState(intf, new InterfaceStateWaiting, this);
+                    changeState(intf, InterfaceStateWaiting::getInstance(), this);
                     /*
                      * @sqsq
                      */
@@ -69,7 +75,7 @@ void InterfaceStateDown::processEvent(Ospfv2Interface *intf, Ospfv2Interface::Os
     }
     else if (event == Ospfv2Interface::LOOP_INDICATION) {
         intf->reset();
-        changeState(intf, new InterfaceStateLoopback, this);
+        changeState(intf, InterfaceStateLoopback::getInstance(), this);
     }
 }
 
@@ -11,14 +11,20 @@
 namespace inet {
 namespace ospfv2 {
 
+InterfaceStateLoopback *InterfaceStateLoopback::getInstance()
+{
+    static InterfaceStateLoopback instance;
+    return &instance;
+}
+
 void InterfaceStateLoopback::processEvent(Ospfv2Interface *intf, Ospfv2Interface::Ospfv2InterfaceEventType event)
 {
     if (event == Ospfv2Interface::INTERFACE_DOWN) {
         intf->reset();
-        changeState(intf, new InterfaceStateDown, this);
+        changeState(intf, InterfaceStateDown::getInstance(), this);
     }
     else if (event == Ospfv2Interface::UNLOOP_INDICATION) {
-        changeState(intf, new InterfaceStateDown, this);
+        changeState(intf, InterfaceStateDown::getInstance(), this);
     }
 }
 
@@ -15,6 +15,12 @@
 namespace inet {
 namespace ospfv2 {
 
+InterfaceStateNotDesignatedRouter *InterfaceStateNotDesignatedRouter::getInstance()
+{
+    static InterfaceStateNotDesignatedRouter instance;
+    return &instance;
+}
+
 void InterfaceStateNotDesignatedRouter::processEvent(Ospfv2Interface *intf, Ospfv2Interface::Ospfv2InterfaceEventType event)
 {
     if (event == Ospfv2Interface::NEIGHBOR_CHANGE) {
@@ -22,11 +28,11 @@ void InterfaceStateNotDesignatedRouter::processEvent(Ospfv2Interface *intf, Ospf
     }
     else if (event == Ospfv2Interface::INTERFACE_DOWN) {
         intf->reset();
-        changeState(intf, new InterfaceStateDown, this);
+        changeState(intf, InterfaceStateDown::getInstance(), this);
     }
     else if (event == Ospfv2Interface::LOOP_INDICATION) {
         intf->reset();
-        changeState(intf, new InterfaceStateLoopback, this);
+        changeState(intf, InterfaceStateLoopback::getInstance(), this);
     }
     else if (event == Ospfv2Interface::HELLO_TIMER) {
         if (intf->getType() == Ospfv2Interface::BROADCAST) {
@@ -15,15 +15,21 @@
 namespace inet {
 namespace ospfv2 {
 
+InterfaceStatePointToPoint *InterfaceStatePointToPoint::getInstance()
+{
+    static InterfaceStatePointToPoint instance;
+    return &instance;
+}
+
 void InterfaceStatePointToPoint::processEvent(Ospfv2Interface *intf, Ospfv2Interface::Ospfv2InterfaceEventType event)
 {
     if (event == Ospfv2Interface::INTERFACE_DOWN) {
         intf->reset();
-        changeState(intf, new InterfaceStateDown, this);
+        changeState(intf, InterfaceStateDown::getInstance(), this);
     }
     else if (event == Ospfv2Interface::LOOP_INDICATION) {
         intf->reset();
-        changeState(intf, new InterfaceStateLoopback, this);
+        changeState(intf, InterfaceStateLoopback::getInstance(), this);
     }
     else if (event == Ospfv2Interface::HELLO_TIMER) {
         if (intf->getType() == Ospfv2Interface::VIRTUAL) {
@@ -16,6 +16,8 @@ namespace ospfv2 {
 class INET_API InterfaceStatePointToPoint : public Ospfv2InterfaceState
 {
   public:
+    static InterfaceStatePointToPoint *getInstance();
+
     virtual void processEvent(Ospfv2Interface *intf, Ospfv2Interface::Ospfv2InterfaceEventType event) override;
     virtual Ospfv2Interface::Ospfv2InterfaceStateType getState() const override { return Ospfv2Interface::POINTTOPOINT_STATE; }
 };
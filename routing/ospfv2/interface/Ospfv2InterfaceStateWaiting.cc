@@ -15,6 +15,12 @@
 namespace inet {
 namespace ospfv2 {
 
+InterfaceStateWaiting *InterfaceStateWaiting::getInstance()
+{
+    static InterfaceStateWaiting instance;
+    return &instance;
+}
+
 void InterfaceStateWaiting::processEvent(Ospfv2Interface *intf, Ospfv2Interface::Ospfv2InterfaceEventType event)
 {
     if ((event == Ospfv2Interface::BACKUP_SEEN) ||
@@ -27,11 +33,11 @@ void InterfaceStateWaiting::processEvent(Ospfv2Interface *intf, Ospfv2Interface:
     }
     else if (event == Ospfv2Interface::INTERFACE_DOWN) {
         intf->reset();
-        changeState(intf, new InterfaceStateDown, this);
+        changeState(intf, InterfaceStateDown::getInstance(), this);
     }
     else if (event == Ospfv2Interface::LOOP_INDICATION) {
         intf->reset();
-        changeState(intf, new InterfaceStateLoopback, this);
+        changeState(intf, InterfaceStateLoopback::getInstance(), this);
     }
     else if (event == Ospfv2Interface::HELLO_TIMER) {
         if (intf->getType() == Ospfv2Interface::BROADCAST) {
@@ -16,6 +16,8 @@ namespace ospfv2 {
 class INET_API InterfaceStateWaiting : public Ospfv2InterfaceState
 {
   public:
+    static InterfaceStateWaiting *getInstance();
+
     virtual void processEvent(Ospfv2Interface *intf, Ospfv2Interface::Ospfv2InterfaceEventType event) override;
     virtual Ospfv2Interface::Ospfv2InterfaceStateType getState() const override { return Ospfv2Interface::WAITING_STATE; }
 };
@@ -7,6 +7,7 @@
 #include "inet/routing/ospfv2/messagehandler/HelloHandler.h"
 
 #include "inet/networklayer/common/L3AddressTag_m.h"
+#include "inet/routing/ospfv2/Ospfv2Crc.h"
 #include "inet/routing/ospfv2/interface/Ospfv2Interface.h"
 #include "inet/routing/ospfv2/neighbor/Ospfv2Neighbor.h"
 #include "inet/routing/ospfv2/router/Ospfv2Area.h"
@@ -307,7 +308,7 @@ void HelloHandler::processPacket(Packet *packet, Ospfv2Interface *intf, Neighbor
                             else {
                                 RouterLsa *newLSA = intf->getArea()->originateRouterLSA();
 
-                                newLSA->getHeaderForUpdate().setLsSequenceNumber(sequenceNumber + 1);
+                                setLsaSequenceNumber(*newLSA, sequenceNumber + 1);
                                 shouldRebuildRoutingTable |= routerLSA->update(newLSA);
                                 delete newLSA;
 
@@ -325,7 +326,7 @@ void HelloHandler::processPacket(Packet *packet, Ospfv2Interface *intf, Neighbor
     }
 
     if (shouldRebuildRoutingTable) {
-        router->rebuildRoutingTable();
+        router->requestRoutingTableRebuild();
     }
 }
 
@@ -55,6 +55,7 @@ void LinkStateUpdateHandler::processPacket(Packet *packet, Ospfv2Interface *intf
 
     const auto& lsUpdatePacket = packet->peekAtFront<Ospfv2LinkStateUpdatePacket>();
     bool shouldRebuildRoutingTable = false;
+    cSimpleModule *ospfModule = router->getOspfModule();
 
     if (neighbor->getState() >= Neighbor::EXCHANGE_STATE) {
         AreaId areaID = lsUpdatePacket->getAreaID();
@@ -66,6 +67,7 @@ void LinkStateUpdateHandler::processPacket(Packet *packet, Ospfv2Interface *intf
             const Ospfv2Lsa *currentLSA = lsUpdatePacket->getOspfLSAs(i);
 
             if (!validateLSChecksum(currentLSA)) {
+                ospfModule->emit(Router::lsaRejectedSignal, current_ttl);
                 continue;
             }
 
@@ -76,6 +78,7 @@ void LinkStateUpdateHandler::processPacket(Packet *packet, Ospfv2Interface *intf
                 (lsaType != SUMMARYLSA_ASBOUNDARYROUTERS_TYPE) &&
                 (lsaType != AS_EXTERNAL_LSA_TYPE))
             {
+                ospfModule->emit(Router::lsaRejectedSignal, current_ttl);
                 continue;
             }
 
@@ -84,6 +87,7 @@ void LinkStateUpdateHandler::processPacket(Packet *packet, Ospfv2Interface *intf
 
             // FIXME area maybe nullptr
             if ((lsaType == AS_EXTERNAL_LSA_TYPE) && !(area != nullptr && area->getExternalRoutingCapability())) {
+                ospfModule->emit(Router::lsaRejectedSignal, current_ttl);
                 continue;
             }
             LsaKeyType lsaKey;
@@ -123,6 +127,7 @@ void LinkStateUpdateHandler::processPacket(Packet *packet, Ospfv2Interface *intf
                         intf->sendLsAcknowledgement(&(currentLSA->getHeader()), neighbor->getAddress());
                     }
                 }
+                ospfModule->emit(Router::lsaRejectedSignal, current_ttl);
                 continue;
             }
 
@@ -160,6 +165,7 @@ void LinkStateUpdateHandler::processPacket(Packet *packet, Ospfv2Interface *intf
                     router->removeFromAllRetransmissionLists(lsaKey);  // section 13(5)(c) remove the current LSDB copy from all neighbors' retransmission lists
                 }
                 shouldRebuildRoutingTable |= router->installLSA(currentLSA, areaID);  // section 13(5)(d)
+                ospfModule->emit(Router::lsaInstalledSignal, current_ttl);
 
                 EV_INFO << "    (update installed)\n";
 
@@ -188,7 +194,7 @@ void LinkStateUpdateHandler::processPacket(Packet *packet, Ospfv2Interface *intf
                                 router->floodLSA(lsaInDatabase, areaID, current_ttl);
                             }
                             else {
-                                lsaInDatabase->getHeaderForUpdate().setLsSequenceNumber(sequenceNumber + 1);
+                                setLsaSequenceNumber(*lsaInDatabase, sequenceNumber + 1);
                                 /*
                                  * @sqsq
                                  */
@@ -200,6 +206,9 @@ void LinkStateUpdateHandler::processPacket(Packet *packet, Ospfv2Interface *intf
                 continue;
             }
 
+            // the LSA is not installed in any of the remaining cases
+            ospfModule->emit(Router::lsaRejectedSignal, current_ttl);
+
             if (neighbor->isLSAOnRequestList(lsaKey)) {  // 13(6)
                 neighbor->processEvent(Neighbor::BAD_LINK_STATE_REQUEST);
                 break;
@@ -255,7 +264,7 @@ void LinkStateUpdateHandler::processPacket(Packet *packet, Ospfv2Interface *intf
     }
 
     if (shouldRebuildRoutingTable)
-        router->rebuildRoutingTable();
+        router->requestRoutingTableRebuild();
 }
 
 void LinkStateUpdateHandler::acknowledgeLSA(const Ospfv2LsaHeader& lsaHeader,
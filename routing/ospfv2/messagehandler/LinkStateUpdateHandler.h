@@ -7,6 +7,7 @@
 #ifndef __INET_LINKSTATEUPDATEHANDLER_H
 #define __INET_LINKSTATEUPDATEHANDLER_H
 
+#include "inet/routing/ospfv2/Ospfv2Crc.h"
 #include "inet/routing/ospfv2/messagehandler/IMessageHandler.h"
 #include "inet/routing/ospfv2/router/Ospfv2Common.h"
 
@@ -28,7 +29,7 @@ class INET_API LinkStateUpdateHandler : public IMessageHandler
     };
 
   private:
-    bool validateLSChecksum(const Ospfv2Lsa *lsa) { return true; } // not implemented
+    bool validateLSChecksum(const Ospfv2Lsa *lsa) { return validateLsaCrc(*lsa); }
     void acknowledgeLSA(const Ospfv2LsaHeader& lsaHeader, Ospfv2Interface *intf, AcknowledgementFlags acknowledgementFlags, RouterId lsaSource);
 
   public:
@@ -26,6 +26,7 @@
 #include "inet/queueing/queue/PacketQueue.h"
 #include "inet/routing/ospfv2/Ospfv2Crc.h"
 #include "inet/routing/ospfv2/router/Ospfv2Common.h"
+#include "inet/routing/ospfv2/router/Ospfv2ResultFiles.h"
 
 namespace inet {
 
@@ -52,6 +53,8 @@ MessageHandler::MessageHandler(Router *containingRouter, cSimpleModule *containi
         controlPacketSize[type] = 0;
     }
     this->containingRouter = containingRouter;
+    if (containingModule->par("coalesceTimers"))
+        timerMultiplexer = new TimerMultiplexer(containingModule, "OSPF-timers");
 }
 
 /*
@@ -59,20 +62,9 @@ MessageHandler::MessageHandler(Router *containingRouter, cSimpleModule *containi
  */
 MessageHandler::~MessageHandler()
 {
-    std::string filename = "/home/sqsq/Desktop/"
-            "sat-ospf/inet/examples/ospfv2/sqsqtest/results/";
-    filename += EXPERIMENT_NAME;
-    filename += "/";
-
-    filename += IS_OSPF ? "OSPF" : std::to_string(SQSQ_HOP);
-
-    filename += "/";
-    filename += getEnvir()->getConfigEx()->getActiveConfigName();
-    filename += "/controlOverhead.csv";
-    std::ofstream ofs;
+    std::ostream& ofs = Ospfv2ResultFiles::getFile("controlOverhead.csv");
     int tot = 0;
 
-    ofs.open(filename, std::ios::app);
     ofs << getEnvir()->getConfigEx()->getActiveConfigName() << ",";
     ofs << SQSQ_HOP << ",";
     ofs << containingRouter->getRouterID() << ",";
@@ -85,7 +77,8 @@ MessageHandler::~MessageHandler()
     }
     ofs << tot;
     ofs << std::endl;
-    ofs.close();
+
+    delete timerMultiplexer;
 
 //    std::cout << "avg LSU size: " << (double)controlPacketSize[LINKSTATE_UPDATE_PACKET] / controlPacketCount[LINKSTATE_UPDATE_PACKET] << std::endl;
 //    std::cout << "LSU count: " << controlPacketCount[LINKSTATE_UPDATE_PACKET] << std::endl;
@@ -93,7 +86,10 @@ MessageHandler::~MessageHandler()
 
 void MessageHandler::messageReceived(cMessage *message)
 {
-    if (message->isSelfMessage()) {
+    if (timerMultiplexer != nullptr && timerMultiplexer->isMultiplexerMessage(message)) {
+        timerMultiplexer->processDueTimers([this] (cMessage *timer) { handleTimer(timer); });
+    }
+    else if (message->isSelfMessage()) {
         handleTimer(message);
     }
     else {
@@ -559,12 +555,18 @@ void MessageHandler::sendPacket(Packet *packet, Ipv4Address destination, Ospfv2I
 
 void MessageHandler::clearTimer(cMessage *timer)
 {
-    ospfModule->cancelEvent(timer);
+    if (timerMultiplexer != nullptr)
+        timerMultiplexer->cancel(timer);
+    else
+        ospfModule->cancelEvent(timer);
 }
 
 void MessageHandler::startTimer(cMessage *timer, simtime_t delay)
 {
-    ospfModule->scheduleAfter(delay, timer);
+    if (timerMultiplexer != nullptr)
+        timerMultiplexer->scheduleAfter(delay, timer);
+    else
+        ospfModule->scheduleAfter(delay, timer);
 }
 
 void MessageHandler::printEvent(const char *eventString, const Ospfv2Interface *onInterface, const Neighbor *forNeighbor /*= nullptr*/) const
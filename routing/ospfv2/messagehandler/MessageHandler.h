@@ -8,6 +8,8 @@
 #define __INET_MESSAGEHANDLER_H
 
 #include <set>
+
+#include "inet/common/TimerMultiplexer.h"
 #include "inet/routing/ospfv2/interface/Ospfv2Interface.h"
 #include "inet/routing/ospfv2/messagehandler/DatabaseDescriptionHandler.h"
 #include "inet/routing/ospfv2/messagehandler/HelloHandler.h"
@@ -23,6 +25,7 @@ class INET_API MessageHandler : public IMessageHandler
 {
   private:
     cSimpleModule *ospfModule;
+    TimerMultiplexer *timerMultiplexer = nullptr; // all protocol timers share one self message if set
 
     HelloHandler helloHandler;
     DatabaseDescriptionHandler ddHandler;
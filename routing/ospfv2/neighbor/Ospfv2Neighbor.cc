@@ -13,6 +13,7 @@
 #include "inet/routing/ospfv2/messagehandler/MessageHandler.h"
 #include "inet/routing/ospfv2/neighbor/Ospfv2NeighborState.h"
 #include "inet/routing/ospfv2/neighbor/Ospfv2NeighborStateDown.h"
+#include "inet/routing/ospfv2/neighbor/Ospfv2NeighborStateFull.h"
 #include "inet/routing/ospfv2/router/Ospfv2Area.h"
 #include "inet/routing/ospfv2/router/Ospfv2Router.h"
 #include "inet/routing/ospfv2/router/Ospfv2Common.h"
@@ -48,8 +49,7 @@ Neighbor::Neighbor(RouterId neighbor) :
     updateRetransmissionTimer->setContextPointer(this);
     requestRetransmissionTimer = new cMessage("Neighbor::NeighborRequestRetransmissionTimer", NEIGHBOR_REQUEST_RETRANSMISSION_TIMER);
     requestRetransmissionTimer->setContextPointer(this);
-    state = new NeighborStateDown;
-    previousState = nullptr;
+    state = NeighborStateDown::getInstance();
     /*
      * @sqsq
      */
@@ -70,9 +70,6 @@ Neighbor::~Neighbor()
     delete ddRetransmissionTimer;
     delete updateRetransmissionTimer;
     delete requestRetransmissionTimer;
-    if (previousState)
-        delete previousState;
-    delete state;
 }
 
 void Neighbor::changeState(NeighborState *newState, NeighborState *currentState)
@@ -81,11 +78,8 @@ void Neighbor::changeState(NeighborState *newState, NeighborState *currentState)
             << " from '" << getStateString(currentState->getState())
             << "' to '" << getStateString(newState->getState()) << "'" << std::endl;
 
-    if (previousState != nullptr) {
-        delete previousState;
-    }
     state = newState;
-    previousState = currentState;
+    previousState = currentState->getState();
 }
 
 void Neighbor::processEvent(Neighbor::NeighborEventType event)
@@ -126,6 +120,18 @@ void Neighbor::reset()
     }
 }
 
+void Neighbor::restoreFullState()
+{
+    reset();
+    if (!firstAdjacencyInited)
+        initFirstAdjacency();
+    if (state->getState() != FULL_STATE)
+        changeState(NeighborStateFull::getInstance(), state);
+    MessageHandler *messageHandler = parentInterface->getArea()->getRouter()->getMessageHandler();
+    messageHandler->clearTimer(inactivityTimer);
+    messageHandler->startTimer(inactivityTimer, neighborsRouterDeadInterval);
+}
+
 void Neighbor::initFirstAdjacency()
 {
     ddSequenceNumber = getUniqueULong();
@@ -661,7 +667,9 @@ void Neighbor::retransmitUpdatePacket()
         if (includeLSA) {
             packetLength += lsaSize;
             unsigned int ospfLSACount = updatePacket->getOspfLSAsArraySize();
-            setLsaCrc(*ospfLsa, parentInterface->getCrcMode());
+            // the LS age is not covered by the LS checksum, a valid computed checksum can be kept
+            if (ospfLsa->getHeader().getLsCrcMode() != parentInterface->getCrcMode())
+                setLsaCrc(*ospfLsa, parentInterface->getCrcMode());
 
             updatePacket->setOspfLSAsArraySize(ospfLSACount + 1);
             updatePacket->setOspfLSAs(ospfLSACount, ospfLsa->dup());
@@ -687,6 +695,7 @@ void Neighbor::retransmitUpdatePacket()
     }
 
     setOspfCrc(updatePacket, parentInterface->getCrcMode());
+    parentInterface->getArea()->getRouter()->getOspfModule()->emit(Router::lsaRetransmittedSignal, lsaCount);
 
     Packet *pk = new Packet();
     pk->insertAtBack(updatePacket);
@@ -75,8 +75,8 @@ class INET_API Neighbor
     };
 
   private:
-    NeighborState *state = nullptr;
-    NeighborState *previousState = nullptr;
+    NeighborState *state = nullptr; // shared, stateless instance; see NeighborState
+    NeighborStateType previousState = DOWN_STATE;
     cMessage *inactivityTimer = nullptr;
     cMessage *pollTimer = nullptr;
     cMessage *ddRetransmissionTimer = nullptr;
@@ -121,8 +121,17 @@ class INET_API Neighbor
 
     void processEvent(NeighborEventType event);
     void reset();
+
+    /**
+     * Puts the neighbor into FULL state without a database exchange and starts
+     * its inactivity timer, as if a Hello had just been received. Used when the
+     * databases are installed by other means (e.g. from a snapshot); the caller
+     * is responsible for rebuilding the routing table.
+     */
+    void restoreFullState();
     void initFirstAdjacency();
     NeighborStateType getState() const;
+    NeighborStateType getPreviousState() const { return previousState; }
     static const char *getStateString(NeighborStateType stateType);
     void sendDatabaseDescriptionPacket(bool init = false);
     bool retransmitDatabaseDescriptionPacket();
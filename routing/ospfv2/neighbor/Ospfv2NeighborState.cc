@@ -6,6 +6,7 @@
 
 #include "inet/routing/ospfv2/neighbor/Ospfv2NeighborState.h"
 
+#include "inet/routing/ospfv2/Ospfv2Crc.h"
 #include "inet/routing/ospfv2/interface/Ospfv2Interface.h"
 #include "inet/routing/ospfv2/router/Ospfv2Area.h"
 #include "inet/routing/ospfv2/router/Ospfv2Router.h"
@@ -20,7 +21,7 @@ void NeighborState::changeState(Neighbor *neighbor, NeighborState *newState, Nei
 
     if ((currentState->getState() == Neighbor::FULL_STATE) || (newState->getState() == Neighbor::FULL_STATE))
         if (updateLsa(neighbor))
-            neighbor->getInterface()->getArea()->getRouter()->rebuildRoutingTable();
+            neighbor->getInterface()->getArea()->getRouter()->requestRoutingTableRebuild();
 
     /*
      * @sqsq
@@ -55,7 +56,7 @@ bool NeighborState::updateLsa(Neighbor *neighbor)
         else {
             RouterLsa *newLSA = neighbor->getInterface()->getArea()->originateRouterLSA();
 
-            newLSA->getHeaderForUpdate().setLsSequenceNumber(sequenceNumber + 1);
+            setLsaSequenceNumber(*newLSA, sequenceNumber + 1);
             shouldRebuildRoutingTable |= routerLSA->update(newLSA);
             delete newLSA;
 
@@ -77,7 +78,7 @@ bool NeighborState::updateLsa(Neighbor *neighbor)
                 NetworkLsa *newLSA = neighbor->getInterface()->getArea()->originateNetworkLSA(neighbor->getInterface());
 
                 if (newLSA != nullptr) {
-                    newLSA->getHeaderForUpdate().setLsSequenceNumber(sequenceNumber + 1);
+                    setLsaSequenceNumber(*newLSA, sequenceNumber + 1);
                     shouldRebuildRoutingTable |= networkLSA->update(newLSA);
                     delete newLSA;
                 }
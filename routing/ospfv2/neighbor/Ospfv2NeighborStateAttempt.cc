@@ -17,13 +17,19 @@ namespace inet {
 
 namespace ospfv2 {
 
+NeighborStateAttempt *NeighborStateAttempt::getInstance()
+{
+    static NeighborStateAttempt instance;
+    return &instance;
+}
+
 void NeighborStateAttempt::processEvent(Neighbor *neighbor, Neighbor::NeighborEventType event)
 {
     if ((event == Neighbor::KILL_NEIGHBOR) || (event == Neighbor::LINK_DOWN)) {
         MessageHandler *messageHandler = neighbor->getInterface()->getArea()->getRouter()->getMessageHandler();
         neighbor->reset();
         messageHandler->clearTimer(neighbor->getInactivityTimer());
-        changeState(neighbor, new NeighborStateDown, this);
+        changeState(neighbor, NeighborStateDown::getInstance(), this);
     }
     else if (event == Neighbor::INACTIVITY_TIMER) {
         neighbor->reset();
@@ -31,13 +37,13 @@ void NeighborStateAttempt::processEvent(Neighbor *neighbor, Neighbor::NeighborEv
             MessageHandler *messageHandler = neighbor->getInterface()->getArea()->getRouter()->getMessageHandler();
             messageHandler->startTimer(neighbor->getPollTimer(), neighbor->getInterface()->getPollInterval());
         }
-        changeState(neighbor, new NeighborStateDown, this);
+        changeState(neighbor, NeighborStateDown::getInstance(), this);
     }
     else if (event == Neighbor::HELLO_RECEIVED) {
         MessageHandler *messageHandler = neighbor->getInterface()->getArea()->getRouter()->getMessageHandler();
         messageHandler->clearTimer(neighbor->getInactivityTimer());
         messageHandler->startTimer(neighbor->getInactivityTimer(), neighbor->getRouterDeadInterval());
-        changeState(neighbor, new NeighborStateInit, this);
+        changeState(neighbor, NeighborStateInit::getInstance(), this);
     }
 }
 
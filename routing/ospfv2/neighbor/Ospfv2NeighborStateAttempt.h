@@ -16,6 +16,8 @@ namespace ospfv2 {
 class INET_API NeighborStateAttempt : public NeighborState
 {
   public:
+    static NeighborStateAttempt *getInstance();
+
     virtual void processEvent(Neighbor *neighbor, Neighbor::NeighborEventType event) override;
     virtual Neighbor::NeighborStateType getState() const override { return Neighbor::ATTEMPT_STATE; }
 };
@@ -17,6 +17,12 @@ namespace inet {
 
 namespace ospfv2 {
 
+NeighborStateDown *NeighborStateDown::getInstance()
+{
+    static NeighborStateDown instance;
+    return &instance;
+}
+
 void NeighborStateDown::processEvent(Neighbor *neighbor, Neighbor::NeighborEventType event)
 {
     if (event == Neighbor::START) {
@@ -32,7 +38,7 @@ void NeighborStateDown::processEvent(Neighbor *neighbor, Neighbor::NeighborEvent
          */
         neighbor->setNeiborInitTime(simTime());
 
-        changeState(neighbor, new NeighborStateAttempt, this);
+        changeState(neighbor, NeighborStateAttempt::getInstance(), this);
     }
     else if (event == Neighbor::HELLO_RECEIVED) {
         MessageHandler *messageHandler = neighbor->getInterface()->getArea()->getRouter()->getMessageHandler();
@@ -45,7 +51,7 @@ void NeighborStateDown::processEvent(Neighbor *neighbor, Neighbor::NeighborEvent
         neighbor->setNeiborInitTime(simTime());
 
 
-        changeState(neighbor, new NeighborStateInit, this);
+        changeState(neighbor, NeighborStateInit::getInstance(), this);
     }
     else if (event == Neighbor::POLL_TIMER) {
         int ttl = (neighbor->getInterface()->getType() == Ospfv2Interface::VIRTUAL) ? VIRTUAL_LINK_TTL : 1;
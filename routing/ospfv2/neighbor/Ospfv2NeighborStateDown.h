@@ -16,6 +16,8 @@ namespace ospfv2 {
 class INET_API NeighborStateDown : public NeighborState
 {
   public:
+    static NeighborStateDown *getInstance();
+
     virtual void processEvent(Neighbor *neighbor, Neighbor::NeighborEventType event) override;
     virtual Neighbor::NeighborStateType getState() const override { return Neighbor::DOWN_STATE; }
 };
@@ -23,13 +23,19 @@ namespace inet {
 
 namespace ospfv2 {
 
+NeighborStateExchange *NeighborStateExchange::getInstance()
+{
+    static NeighborStateExchange instance;
+    return &instance;
+}
+
 void NeighborStateExchange::processEvent(Neighbor *neighbor, Neighbor::NeighborEventType event)
 {
     if ((event == Neighbor::KILL_NEIGHBOR) || (event == Neighbor::LINK_DOWN)) {
         MessageHandler *messageHandler = neighbor->getInterface()->getArea()->getRouter()->getMessageHandler();
         neighbor->reset();
         messageHandler->clearTimer(neighbor->getInactivityTimer());
-        changeState(neighbor, new NeighborStateDown, this);
+        changeState(neighbor, NeighborStateDown::getInstance(), this);
     }
     else if (event == Neighbor::INACTIVITY_TIMER) {
         neighbor->reset();
@@ -37,11 +43,11 @@ void NeighborStateExchange::processEvent(Neighbor *neighbor, Neighbor::NeighborE
             MessageHandler *messageHandler = neighbor->getInterface()->getArea()->getRouter()->getMessageHandler();
             messageHandler->startTimer(neighbor->getPollTimer(), neighbor->getInterface()->getPollInterval());
         }
-        changeState(neighbor, new NeighborStateDown, this);
+        changeState(neighbor, NeighborStateDown::getInstance(), this);
     }
     else if (event == Neighbor::ONEWAY_RECEIVED) {
         neighbor->reset();
-        changeState(neighbor, new NeighborStateInit, this);
+        changeState(neighbor, NeighborStateInit::getInstance(), this);
     }
     else if (event == Neighbor::HELLO_RECEIVED) {
         MessageHandler *messageHandler = neighbor->getInterface()->getArea()->getRouter()->getMessageHandler();
@@ -51,7 +57,7 @@ void NeighborStateExchange::processEvent(Neighbor *neighbor, Neighbor::NeighborE
     else if (event == Neighbor::IS_ADJACENCY_OK) {
         if (!neighbor->needAdjacency()) {
             neighbor->reset();
-            changeState(neighbor, new NeighborStateTwoWay, this);
+            changeState(neighbor, NeighborStateTwoWay::getInstance(), this);
         }
     }
     else if ((event == Neighbor::SEQUENCE_NUMBER_MISMATCH) || (event == Neighbor::BAD_LINK_STATE_REQUEST)) {
@@ -60,20 +66,20 @@ void NeighborStateExchange::processEvent(Neighbor *neighbor, Neighbor::NeighborE
         neighbor->incrementDDSequenceNumber();
         neighbor->sendDatabaseDescriptionPacket(true);
         messageHandler->startTimer(neighbor->getDDRetransmissionTimer(), neighbor->getInterface()->getRetransmissionInterval());
-        changeState(neighbor, new NeighborStateExchangeStart, this);
+        changeState(neighbor, NeighborStateExchangeStart::getInstance(), this);
     }
     else if (event == Neighbor::EXCHANGE_DONE) {
         if (neighbor->isLinkStateRequestListEmpty()) {
             MessageHandler *messageHandler = neighbor->getInterface()->getArea()->getRouter()->getMessageHandler();
             messageHandler->startTimer(neighbor->getDDRetransmissionTimer(), neighbor->getRouterDeadInterval());
             neighbor->clearRequestRetransmissionTimer();
-            changeState(neighbor, new NeighborStateFull, this);
+            changeState(neighbor, NeighborStateFull::getInstance(), this);
         }
         else {
 //            std::cout << simTime() << "LOADING" << std::endl;
             MessageHandler *messageHandler = neighbor->getInterface()->getArea()->getRouter()->getMessageHandler();
             messageHandler->startTimer(neighbor->getDDRetransmissionTimer(), neighbor->getRouterDeadInterval());
-            changeState(neighbor, new NeighborStateLoading, this);
+            changeState(neighbor, NeighborStateLoading::getInstance(), this);
         }
     }
     else if (event == Neighbor::UPDATE_RETRANSMISSION_TIMER) {
@@ -16,6 +16,8 @@ namespace ospfv2 {
 class INET_API NeighborStateExchange : public NeighborState
 {
   public:
+    static NeighborStateExchange *getInstance();
+
     virtual void processEvent(Neighbor *neighbor, Neighbor::NeighborEventType event) override;
     virtual Neighbor::NeighborStateType getState() const override { return Neighbor::EXCHANGE_STATE; }
 };
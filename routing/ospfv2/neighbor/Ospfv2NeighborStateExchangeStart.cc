@@ -19,13 +19,19 @@ namespace inet {
 
 namespace ospfv2 {
 
+NeighborStateExchangeStart *NeighborStateExchangeStart::getInstance()
+{
+    static NeighborStateExchangeStart instance;
+    return &instance;
+}
+
 void NeighborStateExchangeStart::processEvent(Neighbor *neighbor, Neighbor::NeighborEventType event)
 {
     if ((event == Neighbor::KILL_NEIGHBOR) || (event == Neighbor::LINK_DOWN)) {
         MessageHandler *messageHandler = neighbor->getInterface()->getArea()->getRouter()->getMessageHandler();
         neighbor->reset();
         messageHandler->clearTimer(neighbor->getInactivityTimer());
-        changeState(neighbor, new NeighborStateDown, this);
+        changeState(neighbor, NeighborStateDown::getInstance(), this);
     }
     else if (event == Neighbor::INACTIVITY_TIMER) {
         neighbor->reset();
@@ -33,11 +39,11 @@ void NeighborStateExchangeStart::processEvent(Neighbor *neighbor, Neighbor::Neig
             MessageHandler *messageHandler = neighbor->getInterface()->getArea()->getRouter()->getMessageHandler();
             messageHandler->startTimer(neighbor->getPollTimer(), neighbor->getInterface()->getPollInterval());
         }
-        changeState(neighbor, new NeighborStateDown, this);
+        changeState(neighbor, NeighborStateDown::getInstance(), this);
     }
     else if (event == Neighbor::ONEWAY_RECEIVED) {
         neighbor->reset();
-        changeState(neighbor, new NeighborStateInit, this);
+        changeState(neighbor, NeighborStateInit::getInstance(), this);
     }
     else if (event == Neighbor::HELLO_RECEIVED) {
         MessageHandler *messageHandler = neighbor->getInterface()->getArea()->getRouter()->getMessageHandler();
@@ -47,7 +53,7 @@ void NeighborStateExchangeStart::processEvent(Neighbor *neighbor, Neighbor::Neig
     else if (event == Neighbor::IS_ADJACENCY_OK) {
         if (!neighbor->needAdjacency()) {
             neighbor->reset();
-            changeState(neighbor, new NeighborStateTwoWay, this);
+            changeState(neighbor, NeighborStateTwoWay::getInstance(), this);
         }
     }
     else if (event == Neighbor::DD_RETRANSMISSION_TIMER) {
@@ -60,7 +66,7 @@ void NeighborStateExchangeStart::processEvent(Neighbor *neighbor, Neighbor::Neig
         neighbor->sendDatabaseDescriptionPacket();
         MessageHandler *messageHandler = neighbor->getInterface()->getArea()->getRouter()->getMessageHandler();
         messageHandler->clearTimer(neighbor->getDDRetransmissionTimer());
-        changeState(neighbor, new NeighborStateExchange, this);
+        changeState(neighbor, NeighborStateExchange::getInstance(), this);
     }
 }
 
@@ -16,6 +16,8 @@ namespace ospfv2 {
 class INET_API NeighborStateExchangeStart : public NeighborState
 {
   public:
+    static NeighborStateExchangeStart *getInstance();
+
     virtual void processEvent(Neighbor *neighbor, Neighbor::NeighborEventType event) override;
     virtual Neighbor::NeighborStateType getState() const override { return Neighbor::EXCHANGE_START_STATE; }
 };
@@ -18,13 +18,19 @@
 namespace inet {
 namespace ospfv2 {
 
+NeighborStateFull *NeighborStateFull::getInstance()
+{
+    static NeighborStateFull instance;
+    return &instance;
+}
+
 void NeighborStateFull::processEvent(Neighbor *neighbor, Neighbor::NeighborEventType event)
 {
     if ((event == Neighbor::KILL_NEIGHBOR) || (event == Neighbor::LINK_DOWN)) {
         MessageHandler *messageHandler = neighbor->getInterface()->getArea()->getRouter()->getMessageHandler();
         neighbor->reset();
         messageHandler->clearTimer(neighbor->getInactivityTimer());
-        changeState(neighbor, new NeighborStateDown, this);
+        changeState(neighbor, NeighborStateDown::getInstance(), this);
     }
     else if (event == Neighbor::INACTIVITY_TIMER) {
         neighbor->reset();
@@ -32,7 +38,7 @@ void NeighborStateFull::processEvent(Neighbor *neighbor, Neighbor::NeighborEvent
             MessageHandler *messageHandler = neighbor->getInterface()->getArea()->getRouter()->getMessageHandler();
             messageHandler->startTimer(neighbor->getPollTimer(), neighbor->getInterface()->getPollInterval());
         }
-        changeState(neighbor, new NeighborStateDown, this);
+        changeState(neighbor, NeighborStateDown::getInstance(), this);
 
         if (neighbor->getInterface()->getState() == Ospfv2Interface::BACKUP_STATE &&
             neighbor->getInterface()->getDesignatedRouter().routerID == neighbor->getNeighborID())
@@ -40,7 +46,7 @@ void NeighborStateFull::processEvent(Neighbor *neighbor, Neighbor::NeighborEvent
     }
     else if (event == Neighbor::ONEWAY_RECEIVED) {
         neighbor->reset();
-        changeState(neighbor, new NeighborStateInit, this);
+        changeState(neighbor, NeighborStateInit::getInstance(), this);
     }
     else if (event == Neighbor::HELLO_RECEIVED) {
         MessageHandler *messageHandler = neighbor->getInterface()->getArea()->getRouter()->getMessageHandler();
@@ -50,7 +56,7 @@ void NeighborStateFull::processEvent(Neighbor *neighbor, Neighbor::NeighborEvent
     else if (event == Neighbor::IS_ADJACENCY_OK) {
         if (!neighbor->needAdjacency()) {
             neighbor->reset();
-            changeState(neighbor, new NeighborStateTwoWay, this);
+            changeState(neighbor, NeighborStateTwoWay::getInstance(), this);
         }
     }
     else if ((event == Neighbor::SEQUENCE_NUMBER_MISMATCH) || (event == Neighbor::BAD_LINK_STATE_REQUEST)) {
@@ -59,7 +65,7 @@ void NeighborStateFull::processEvent(Neighbor *neighbor, Neighbor::NeighborEvent
         neighbor->incrementDDSequenceNumber();
         neighbor->sendDatabaseDescriptionPacket(true);
         messageHandler->startTimer(neighbor->getDDRetransmissionTimer(), neighbor->getInterface()->getRetransmissionInterval());
-        changeState(neighbor, new NeighborStateExchangeStart, this);
+        changeState(neighbor, NeighborStateExchangeStart::getInstance(), this);
     }
     else if (event == Neighbor::UPDATE_RETRANSMISSION_TIMER) {
         neighbor->retransmitUpdatePacket();
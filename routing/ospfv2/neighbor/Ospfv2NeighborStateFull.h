@@ -16,6 +16,8 @@ namespace ospfv2 {
 class INET_API NeighborStateFull : public NeighborState
 {
   public:
+    static NeighborStateFull *getInstance();
+
     virtual void processEvent(Neighbor *neighbor, Neighbor::NeighborEventType event) override;
     virtual Neighbor::NeighborStateType getState() const override { return Neighbor::FULL_STATE; }
 };
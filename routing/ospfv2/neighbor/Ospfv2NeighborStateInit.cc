@@ -17,13 +17,19 @@
 namespace inet {
 namespace ospfv2 {
 
+NeighborStateInit *NeighborStateInit::getInstance()
+{
+    static NeighborStateInit instance;
+    return &instance;
+}
+
 void NeighborStateInit::processEvent(Neighbor *neighbor, Neighbor::NeighborEventType event)
 {
     if ((event == Neighbor::KILL_NEIGHBOR) || (event == Neighbor::LINK_DOWN)) {
         MessageHandler *messageHandler = neighbor->getInterface()->getArea()->getRouter()->getMessageHandler();
         neighbor->reset();
         messageHandler->clearTimer(neighbor->getInactivityTimer());
-        changeState(neighbor, new NeighborStateDown, this);
+        changeState(neighbor, NeighborStateDown::getInstance(), this);
     }
     else if (event == Neighbor::INACTIVITY_TIMER) {
         neighbor->reset();
@@ -31,7 +37,7 @@ void NeighborStateInit::processEvent(Neighbor *neighbor, Neighbor::NeighborEvent
             MessageHandler *messageHandler = neighbor->getInterface()->getArea()->getRouter()->getMessageHandler();
             messageHandler->startTimer(neighbor->getPollTimer(), neighbor->getInterface()->getPollInterval());
         }
-        changeState(neighbor, new NeighborStateDown, this);
+        changeState(neighbor, NeighborStateDown::getInstance(), this);
     }
     else if (event == Neighbor::HELLO_RECEIVED) {
         MessageHandler *messageHandler = neighbor->getInterface()->getArea()->getRouter()->getMessageHandler();
@@ -49,10 +55,10 @@ void NeighborStateInit::processEvent(Neighbor *neighbor, Neighbor::NeighborEvent
             }
             neighbor->sendDatabaseDescriptionPacket(true);
             messageHandler->startTimer(neighbor->getDDRetransmissionTimer(), neighbor->getInterface()->getRetransmissionInterval());
-            changeState(neighbor, new NeighborStateExchangeStart, this);
+            changeState(neighbor, NeighborStateExchangeStart::getInstance(), this);
         }
         else {
-            changeState(neighbor, new NeighborStateTwoWay, this);
+            changeState(neighbor, NeighborStateTwoWay::getInstance(), this);
         }
     }
 }
@@ -16,6 +16,8 @@ namespace ospfv2 {
 class INET_API NeighborStateInit : public NeighborState
 {
   public:
+    static NeighborStateInit *getInstance();
+
     virtual void processEvent(Neighbor *neighbor, Neighbor::NeighborEventType event) override;
     virtual Neighbor::NeighborStateType getState() const override { return Neighbor::INIT_STATE; }
 };
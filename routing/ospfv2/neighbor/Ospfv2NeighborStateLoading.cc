@@ -21,13 +21,19 @@
 namespace inet {
 namespace ospfv2 {
 
+NeighborStateLoading *NeighborStateLoading::getInstance()
+{
+    static NeighborStateLoading instance;
+    return &instance;
+}
+
 void NeighborStateLoading::processEvent(Neighbor *neighbor, Neighbor::NeighborEventType event)
 {
     if ((event == Neighbor::KILL_NEIGHBOR) || (event == Neighbor::LINK_DOWN)) {
         MessageHandler *messageHandler = neighbor->getInterface()->getArea()->getRouter()->getMessageHandler();
         neighbor->reset();
         messageHandler->clearTimer(neighbor->getInactivityTimer());
-        changeState(neighbor, new NeighborStateDown, this);
+        changeState(neighbor, NeighborStateDown::getInstance(), this);
     }
     else if (event == Neighbor::INACTIVITY_TIMER) {
         neighbor->reset();
@@ -35,11 +41,11 @@ void NeighborStateLoading::processEvent(Neighbor *neighbor, Neighbor::NeighborEv
             MessageHandler *messageHandler = neighbor->getInterface()->getArea()->getRouter()->getMessageHandler();
             messageHandler->startTimer(neighbor->getPollTimer(), neighbor->getInterface()->getPollInterval());
         }
-        changeState(neighbor, new NeighborStateDown, this);
+        changeState(neighbor, NeighborStateDown::getInstance(), this);
     }
     else if (event == Neighbor::ONEWAY_RECEIVED) {
         neighbor->reset();
-        changeState(neighbor, new NeighborStateInit, this);
+        changeState(neighbor, NeighborStateInit::getInstance(), this);
     }
     else if (event == Neighbor::HELLO_RECEIVED) {
         MessageHandler *messageHandler = neighbor->getInterface()->getArea()->getRouter()->getMessageHandler();
@@ -48,12 +54,12 @@ void NeighborStateLoading::processEvent(Neighbor *neighbor, Neighbor::NeighborEv
     }
     else if (event == Neighbor::LOADING_DONE) {
         neighbor->clearRequestRetransmissionTimer();
-        changeState(neighbor, new NeighborStateFull, this);
+        changeState(neighbor, NeighborStateFull::getInstance(), this);
     }
     else if (event == Neighbor::IS_ADJACENCY_OK) {
         if (!neighbor->needAdjacency()) {
             neighbor->reset();
-            changeState(neighbor, new NeighborStateTwoWay, this);
+            changeState(neighbor, NeighborStateTwoWay::getInstance(), this);
         }
     }
     else if ((event == Neighbor::SEQUENCE_NUMBER_MISMATCH) || (event == Neighbor::BAD_LINK_STATE_REQUEST)) {
@@ -62,7 +68,7 @@ void NeighborStateLoading::processEvent(Neighbor *neighbor, Neighbor::NeighborEv
         neighbor->incrementDDSequenceNumber();
         neighbor->sendDatabaseDescriptionPacket(true);
         messageHandler->startTimer(neighbor->getDDRetransmissionTimer(), neighbor->getInterface()->getRetransmissionInterval());
-        changeState(neighbor, new NeighborStateExchangeStart, this);
+        changeState(neighbor, NeighborStateExchangeStart::getInstance(), this);
     }
     else if (event == Neighbor::REQUEST_RETRANSMISSION_TIMER) {
         neighbor->sendLinkStateRequestPacket();
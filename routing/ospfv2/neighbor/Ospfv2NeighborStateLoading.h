@@ -16,6 +16,8 @@ namespace ospfv2 {
 class INET_API NeighborStateLoading : public NeighborState
 {
   public:
+    static NeighborStateLoading *getInstance();
+
     virtual void processEvent(Neighbor *neighbor, Neighbor::NeighborEventType event) override;
     virtual Neighbor::NeighborStateType getState() const override { return Neighbor::LOADING_STATE; }
 };
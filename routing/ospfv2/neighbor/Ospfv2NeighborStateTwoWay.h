@@ -16,6 +16,8 @@ namespace ospfv2 {
 class INET_API NeighborStateTwoWay : public NeighborState
 {
   public:
+    static NeighborStateTwoWay *getInstance();
+
     virtual void processEvent(Neighbor *neighbor, Neighbor::NeighborEventType event) override;
     virtual Neighbor::NeighborStateType getState() const override { return Neighbor::TWOWAY_STATE; }
 };
@@ -0,0 +1,118 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#include "inet/routing/ospfv2/partitioning/Ospfv2Partitioner.h"
+
+#include <fstream>
+
+#include "inet/common/Topology.h"
+#include "inet/networklayer/common/L3AddressResolver.h"
+#include "inet/networklayer/ipv4/IIpv4RoutingTable.h"
+#include "inet/routing/ospfv2/router/Ospfv2Common.h"
+
+namespace inet {
+
+namespace ospfv2 {
+
+Define_Module(Ospfv2Partitioner);
+
+void Ospfv2Partitioner::initialize(int stage)
+{
+    // the router IDs are assigned by the network layer
+    if (stage == INITSTAGE_LAST) {
+        if (getEnvir()->getParsimNumPartitions() > 1)
+            throw cRuntimeError("The partitioning must be generated by a sequential run");
+        int numPartitions = par("numPartitions");
+        if (numPartitions < 1 || numPartitions > SQSQ_M)
+            throw cRuntimeError("numPartitions must be between 1 and the number of orbit planes (%d)", SQSQ_M);
+        writePartitionFile(par("partitionFile"), numPartitions);
+    }
+}
+
+int Ospfv2Partitioner::getPartitionOfOrbit(int orbit, int numPartitions)
+{
+    if (orbit < 1 || orbit > SQSQ_M)
+        throw cRuntimeError("Invalid orbit plane: %d", orbit);
+    return (orbit - 1) * numPartitions / SQSQ_M;
+}
+
+int Ospfv2Partitioner::getPartitionOfRouter(Ipv4Address routerId, int numPartitions)
+{
+    // router id: (0, 0, intra-orbit id, orbit id)
+    return getPartitionOfOrbit(routerId.getDByte(3), numPartitions);
+}
+
+void Ospfv2Partitioner::writePartitionFile(const char *fileName, int numPartitions)
+{
+    Topology topology;
+    topology.extractByProperty("networkNode");
+
+    // satellites by their orbit plane
+    L3AddressResolver addressResolver;
+    std::map<int, int> partitionByModuleId;
+    for (int i = 0; i < topology.getNumNodes(); i++) {
+        cModule *module = topology.getNode(i)->getModule();
+        IIpv4RoutingTable *rt = addressResolver.findIpv4RoutingTableOf(module);
+        if (rt == nullptr || InterfaceAddressesByRouterID.find(rt->getRouterId()) == InterfaceAddressesByRouterID.end())
+            continue;
+        partitionByModuleId[module->getId()] = getPartitionOfRouter(rt->getRouterId(), numPartitions);
+    }
+    if (partitionByModuleId.empty())
+        throw cRuntimeError("No satellite found in the network");
+
+    // other nodes (e.g. ground stations) go with the first satellite they are connected to
+    int cutLinkCount = 0;
+    double lookahead = -1;
+    for (int i = 0; i < topology.getNumNodes(); i++) {
+        Topology::Node *node = topology.getNode(i);
+        if (partitionByModuleId.find(node->getModuleId()) != partitionByModuleId.end())
+            continue;
+        int partition = 0;
+        for (int j = 0; j < node->getNumOutLinks(); j++) {
+            auto it = partitionByModuleId.find(node->getLinkOut(j)->getLinkOutRemoteNode()->getModuleId());
+            if (it != partitionByModuleId.end()) {
+                partition = it->second;
+                break;
+            }
+        }
+        partitionByModuleId[node->getModuleId()] = partition;
+    }
+
+    // the delay of the links between partitions is the lookahead of the parallel simulation
+    for (int i = 0; i < topology.getNumNodes(); i++) {
+        Topology::Node *node = topology.getNode(i);
+        for (int j = 0; j < node->getNumOutLinks(); j++) {
+            Topology::Link *link = node->getLinkOut(j);
+            if (partitionByModuleId[node->getModuleId()] == partitionByModuleId[link->getLinkOutRemoteNode()->getModuleId()])
+                continue;
+            cChannel *channel = link->getLinkOutLocalGate()->getChannel();
+            double delay = channel != nullptr && channel->hasPar("delay") ? channel->par("delay").doubleValue() : 0;
+            if (delay <= 0)
+                throw cRuntimeError("The link from '%s' to '%s' crosses partitions but has no delay",
+                        node->getModule()->getFullPath().c_str(), link->getLinkOutRemoteNode()->getModule()->getFullPath().c_str());
+            if (lookahead < 0 || delay < lookahead)
+                lookahead = delay;
+            cutLinkCount++;
+        }
+    }
+
+    std::ofstream file(fileName, std::ios::trunc);
+    file << "# Partitioning of " << getSimulation()->getSystemModule()->getFullName() << " generated by " << getFullPath() << "\n";
+    file << "# " << SQSQ_M << " orbit planes on " << numPartitions << " partitions, "
+         << cutLinkCount << " links between partitions, lookahead " << lookahead << "s\n";
+    file << "# include it into a configuration with parallel-simulation = true and parsim-num-partitions = " << numPartitions << "\n";
+    for (int i = 0; i < topology.getNumNodes(); i++) {
+        cModule *module = topology.getNode(i)->getModule();
+        file << module->getFullPath() << ".partition-id = " << partitionByModuleId[module->getId()] << "\n";
+    }
+    file << "# modules outside of the network nodes (configurators, visualizers)\n";
+    file << getSimulation()->getSystemModule()->getFullName() << ".*.partition-id = 0\n";
+    if (!file)
+        throw cRuntimeError("Cannot write partitioning into '%s'", fileName);
+    EV_INFO << "Partitioning of " << topology.getNumNodes() << " nodes written into " << fileName << endl;
+}
+
+} // namespace ospfv2
+
+} // namespace inet
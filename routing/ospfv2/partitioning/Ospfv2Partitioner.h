@@ -0,0 +1,48 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#ifndef __INET_OSPFV2PARTITIONER_H
+#define __INET_OSPFV2PARTITIONER_H
+
+#include <map>
+
+#include "inet/networklayer/contract/ipv4/Ipv4Address.h"
+
+namespace inet {
+
+namespace ospfv2 {
+
+/**
+ * Assigns the orbit planes of the satellite grid to the partitions (logical
+ * processes) of a parallel simulation and writes the assignment as an ini
+ * file fragment. See the NED file for details.
+ */
+class INET_API Ospfv2Partitioner : public cSimpleModule
+{
+  protected:
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void initialize(int stage) override;
+    virtual void handleMessage(cMessage *msg) override { throw cRuntimeError("This module does not handle messages"); }
+
+    virtual void writePartitionFile(const char *fileName, int numPartitions);
+
+  public:
+    /**
+     * Returns the partition of the given orbit plane (1..SQSQ_M). Adjacent
+     * planes are kept together, so only the inter-plane links between two
+     * blocks of planes cross partitions.
+     */
+    static int getPartitionOfOrbit(int orbit, int numPartitions);
+
+    /**
+     * Returns the partition of the satellite with the given router ID.
+     */
+    static int getPartitionOfRouter(Ipv4Address routerId, int numPartitions);
+};
+
+} // namespace ospfv2
+
+} // namespace inet
+
+#endif
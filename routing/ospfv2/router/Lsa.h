@@ -11,6 +11,7 @@
 
 #include <vector>
 
+#include "inet/routing/ospfv2/Ospfv2Crc.h"
 #include "inet/routing/ospfv2/Ospfv2Packet_m.h"
 #include "inet/routing/ospfv2/router/Ospfv2Common.h"
 
@@ -25,10 +26,46 @@ struct NextHop
     RouterId advertisingRouter;
 };
 
+/**
+ * A list of next hops which keeps the first INLINE_CAPACITY elements inside
+ * the object, so that the common case (ECMP fan-out of a satellite with four
+ * ISLs) never touches the heap. Further elements spill over into a vector.
+ */
+class INET_API NextHopVector
+{
+  public:
+    static const unsigned int INLINE_CAPACITY = 4;
+
+  private:
+    NextHop inlineHops[INLINE_CAPACITY];
+    std::vector<NextHop> overflowHops;
+    unsigned int hopCount = 0;
+
+  public:
+    void push_back(const NextHop& nextHop)
+    {
+        if (hopCount < INLINE_CAPACITY)
+            inlineHops[hopCount] = nextHop;
+        else
+            overflowHops.push_back(nextHop);
+        hopCount++;
+    }
+    void clear() { hopCount = 0; overflowHops.clear(); }
+    unsigned int size() const { return hopCount; }
+    bool empty() const { return hopCount == 0; }
+    const NextHop& operator[](unsigned int index) const { return (index < INLINE_CAPACITY) ? inlineHops[index] : overflowHops[index - INLINE_CAPACITY]; }
+    const NextHop& at(unsigned int index) const
+    {
+        if (index >= hopCount)
+            throw cRuntimeError("NextHopVector: index %u out of range (size %u)", index, hopCount);
+        return (*this)[index];
+    }
+};
+
 class INET_API RoutingInfo
 {
   private:
-    std::vector<NextHop> nextHops;
+    NextHopVector nextHops;
     unsigned long distance;
     Ospfv2Lsa *parent;
 
@@ -80,7 +117,7 @@ class INET_API RouterLsa : public Ospfv2RouterLsa,
     RouterLsa(const RouterLsa& lsa) : Ospfv2RouterLsa(lsa), RoutingInfo(lsa), LsaTrackingInfo(lsa) {}
     virtual ~RouterLsa() {}
 
-    bool validateLSChecksum() const { return true; } // not implemented
+    bool validateLSChecksum() const { return validateLsaCrc(*this); }
 
     bool update(const Ospfv2RouterLsa *lsa);
     bool differsFrom(const Ospfv2RouterLsa *routerLSA) const;
@@ -96,7 +133,7 @@ class INET_API NetworkLsa : public Ospfv2NetworkLsa,
     NetworkLsa(const NetworkLsa& lsa) : Ospfv2NetworkLsa(lsa), RoutingInfo(lsa), LsaTrackingInfo(lsa) {}
     virtual ~NetworkLsa() {}
 
-    bool validateLSChecksum() const { return true; } // not implemented
+    bool validateLSChecksum() const { return validateLsaCrc(*this); }
 
     bool update(const Ospfv2NetworkLsa *lsa);
     bool differsFrom(const Ospfv2NetworkLsa *networkLSA) const;
@@ -118,7 +155,7 @@ class INET_API SummaryLsa : public Ospfv2SummaryLsa,
     bool getPurgeable() const { return purgeable; }
     void setPurgeable(bool purge = true) { purgeable = purge; }
 
-    bool validateLSChecksum() const { return true; } // not implemented
+    bool validateLSChecksum() const { return validateLsaCrc(*this); }
 
     bool update(const Ospfv2SummaryLsa *lsa);
     bool differsFrom(const Ospfv2SummaryLsa *summaryLSA) const;
@@ -140,7 +177,7 @@ class INET_API AsExternalLsa : public Ospfv2AsExternalLsa,
     bool getPurgeable() const { return purgeable; }
     void setPurgeable(bool purge = true) { purgeable = purge; }
 
-    bool validateLSChecksum() const { return true; } // not implemented
+    bool validateLSChecksum() const { return validateLsaCrc(*this); }
 
     bool update(const Ospfv2AsExternalLsa *lsa);
     bool differsFrom(const Ospfv2AsExternalLsa *asExternalLSA) const;
@@ -314,25 +314,11 @@ bool Ospfv2Area::installRouterLSA(const Ospfv2RouterLsa *lsa)
         !LOOP_AVOIDANCE ||
         (LOOP_AVOIDANCE && sqsqCalculateManhattanDistance(linkStateID, currentRouterId) <= SQSQ_HOP)
     ) {
-        auto lsaIt = routerLSAsByID.find(linkStateID);
-        if (lsaIt != routerLSAsByID.end()) {
-            LsaKeyType lsaKey;
-
-            lsaKey.linkStateID = lsa->getHeader().getLinkStateID();
-            lsaKey.advertisingRouter = lsa->getHeader().getAdvertisingRouter();
-
-            removeFromAllRetransmissionLists(lsaKey);
-            return lsaIt->second->update(lsa);
-        }
-        else {
-            RouterLsa *lsaCopy = new RouterLsa(*lsa);
-            routerLSAsByID[linkStateID] = lsaCopy;
-            routerLSAs.push_back(lsaCopy);
-            return true;
-        }
+        return storeRouterLSA(lsa);
     }
     else {
         RouterLsa *lsaCopy = new RouterLsa(*lsa);  // 记得释放
+        bool linksAdded = false;
         int x = linkStateID.getDByte(2), y = linkStateID.getDByte(3);
         RouterId neighboringRouterIDs[] = {
             RouterId(0, 0, sqsqRescaleN(x - 1), y), // 上方卫星的id
@@ -349,17 +335,17 @@ bool Ospfv2Area::installRouterLSA(const Ospfv2RouterLsa *lsa)
             int linksArraySize = lsaCopy->getLinksArraySize();
             int direction = getDirection(linkStateID, neighboringRouterID);
             for (int i = 0; i < linksArraySize; ++i) {
-                Ospfv2Link link = lsaCopy->getLinks(i);
+                const Ospfv2Link& link = lsaCopy->getLinks(i);
                 if (link.getType() == POINTTOPOINT_LINK && link.getLinkID() == neighboringRouterID) {
                     // 如果在原始通告的内容里就有该链路的信息
                     // 也要将该链路的cost设置为只有传播时延
+                    // (the computed LS checksum is updated incrementally)
                     if (direction == 0 || direction == 1) {
-                        link.setLinkCost(propagationDelayByID.find(0)->second);
+                        setRouterLsaLinkCost(*lsaCopy, i, propagationDelayByID.find(0)->second);
                     }
                     else {
-                        link.setLinkCost(propagationDelayByID.find(linkStateID.getDByte(2))->second);
+                        setRouterLsaLinkCost(*lsaCopy, i, propagationDelayByID.find(linkStateID.getDByte(2))->second);
                     }
-                    lsaCopy->setLinks(i, link);
                     flag = true;
                 }
             }
@@ -383,6 +369,7 @@ bool Ospfv2Area::installRouterLSA(const Ospfv2RouterLsa *lsa)
                 lsaCopy->setLinksArraySize(linkIndex + 1);
                 lsaCopy->setNumberOfLinks(linkIndex + 1);
                 lsaCopy->setLinks(linkIndex, newLink);
+                linksAdded = true;
             }
         }
 
@@ -398,17 +385,17 @@ bool Ospfv2Area::installRouterLSA(const Ospfv2RouterLsa *lsa)
             std::cout << linkStateID << " " << routerIDByInterfaceAddress.find(neighboringInterfaceAddr)->second << std::endl;
             int direction = getDirection(linkStateID, routerIDByInterfaceAddress.find(neighboringInterfaceAddr)->second);
             for (int i = 0; i < linksArraySize; ++i) {
-                Ospfv2Link link = lsaCopy->getLinks(i);
+                const Ospfv2Link& link = lsaCopy->getLinks(i);
                 if (link.getType() == STUB_LINK && link.getLinkID() == interfaceAddr) {
                     // 如果在原始通告的内容里就有该链路的信息
                     // 也要将该链路的cost设置为只有传播时延
+                    // (the computed LS checksum is updated incrementally)
                     if (direction == 0 || direction == 1) {
-                        link.setLinkCost(propagationDelayByID.find(0)->second);
+                        setRouterLsaLinkCost(*lsaCopy, i, propagationDelayByID.find(0)->second);
                     }
                     else {
-                        link.setLinkCost(propagationDelayByID.find(linkStateID.getDByte(2))->second);
+                        setRouterLsaLinkCost(*lsaCopy, i, propagationDelayByID.find(linkStateID.getDByte(2))->second);
                     }
-                    lsaCopy->setLinks(i, link);
                     flag = true;
                 }
             }
@@ -432,32 +419,42 @@ bool Ospfv2Area::installRouterLSA(const Ospfv2RouterLsa *lsa)
                 lsaCopy->setLinksArraySize(linkIndex + 1);
                 lsaCopy->setNumberOfLinks(linkIndex + 1);
                 lsaCopy->setLinks(linkIndex, newLink);
+                linksAdded = true;
             }
         }
 
+        if (linksAdded) {
+            // the LSA grew, its length and LS checksum must match the new content
+            lsaCopy->getHeaderForUpdate().setLsaLength(calculateLSASize(lsaCopy).get());
+            setLsaCrc(*lsaCopy, lsaCopy->getHeader().getLsCrcMode());
+        }
+
         // 于是现在得到了一个最终装入本卫星LSDB的、经过假设所有链路均正常的LSA
         // 接下来将其装入LSDB
-        auto lsaIt = routerLSAsByID.find(linkStateID);
-        if (lsaIt != routerLSAsByID.end()) {
-            LsaKeyType lsaKey;
-
-            lsaKey.linkStateID = lsaCopy->getHeader().getLinkStateID();
-            lsaKey.advertisingRouter = lsaCopy->getHeader().getAdvertisingRouter();
+        bool ret = storeRouterLSA(lsaCopy);
+        delete lsaCopy;
+        return ret;
+    }
+}
 
-            removeFromAllRetransmissionLists(lsaKey);
-            bool ret = lsaIt->second->update(lsaCopy);
+bool Ospfv2Area::storeRouterLSA(const Ospfv2RouterLsa *lsa)
+{
+    LinkStateId linkStateID = lsa->getHeader().getLinkStateID();
+    auto lsaIt = routerLSAsByID.find(linkStateID);
+    if (lsaIt != routerLSAsByID.end()) {
+        LsaKeyType lsaKey;
 
-            delete lsaCopy;
-            return ret;
-        }
-        else {
-            RouterLsa *newLsaCopy = new RouterLsa(*lsaCopy);
-            routerLSAsByID[linkStateID] = newLsaCopy;
-            routerLSAs.push_back(newLsaCopy);
+        lsaKey.linkStateID = lsa->getHeader().getLinkStateID();
+        lsaKey.advertisingRouter = lsa->getHeader().getAdvertisingRouter();
 
-            delete lsaCopy;
-            return true;
-        }
+        removeFromAllRetransmissionLists(lsaKey);
+        return lsaIt->second->update(lsa);
+    }
+    else {
+        RouterLsa *lsaCopy = new RouterLsa(*lsa);
+        routerLSAsByID[linkStateID] = lsaCopy;
+        routerLSAs.push_back(lsaCopy);
+        return true;
     }
 }
 
@@ -578,7 +575,7 @@ void Ospfv2Area::ageDatabase()
                 else {
                     RouterLsa *newLSA = originateRouterLSA();
 
-                    newLSA->getHeaderForUpdate().setLsSequenceNumber(sequenceNumber + 1);
+                    setLsaSequenceNumber(*newLSA, sequenceNumber + 1);
                     shouldRebuildRoutingTable |= lsa->update(newLSA);
                     delete newLSA;
 
@@ -610,7 +607,7 @@ void Ospfv2Area::ageDatabase()
                     RouterLsa *newLSA = originateRouterLSA();
                     long sequenceNumber = lsa->getHeader().getLsSequenceNumber();
 
-                    newLSA->getHeaderForUpdate().setLsSequenceNumber((sequenceNumber == MAX_SEQUENCE_NUMBER) ? INITIAL_SEQUENCE_NUMBER : sequenceNumber + 1);
+                    setLsaSequenceNumber(*newLSA, (sequenceNumber == MAX_SEQUENCE_NUMBER) ? INITIAL_SEQUENCE_NUMBER : sequenceNumber + 1);
                     shouldRebuildRoutingTable |= lsa->update(newLSA);
                     delete newLSA;
 
@@ -671,7 +668,7 @@ void Ospfv2Area::ageDatabase()
                     NetworkLsa *newLSA = originateNetworkLSA(localIntf);
 
                     if (newLSA != nullptr) {
-                        newLSA->getHeaderForUpdate().setLsSequenceNumber(sequenceNumber + 1);
+                        setLsaSequenceNumber(*newLSA, sequenceNumber + 1);
                         shouldRebuildRoutingTable |= lsa->update(newLSA);
                         delete newLSA;
                     }
@@ -709,7 +706,7 @@ void Ospfv2Area::ageDatabase()
                     long sequenceNumber = lsa->getHeader().getLsSequenceNumber();
 
                     if (newLSA != nullptr) {
-                        newLSA->getHeaderForUpdate().setLsSequenceNumber((sequenceNumber == MAX_SEQUENCE_NUMBER) ? INITIAL_SEQUENCE_NUMBER : sequenceNumber + 1);
+                        setLsaSequenceNumber(*newLSA, (sequenceNumber == MAX_SEQUENCE_NUMBER) ? INITIAL_SEQUENCE_NUMBER : sequenceNumber + 1);
                         shouldRebuildRoutingTable |= lsa->update(newLSA);
                         delete newLSA;
 
@@ -765,7 +762,7 @@ void Ospfv2Area::ageDatabase()
                     SummaryLsa *newLSA = originateSummaryLSA(lsa);
 
                     if (newLSA != nullptr) {
-                        newLSA->getHeaderForUpdate().setLsSequenceNumber(sequenceNumber + 1);
+                        setLsaSequenceNumber(*newLSA, sequenceNumber + 1);
                         shouldRebuildRoutingTable |= lsa->update(newLSA);
                         delete newLSA;
 
@@ -804,7 +801,7 @@ void Ospfv2Area::ageDatabase()
                     if (newLSA != nullptr) {
                         long sequenceNumber = lsa->getHeader().getLsSequenceNumber();
 
-                        newLSA->getHeaderForUpdate().setLsSequenceNumber((sequenceNumber == MAX_SEQUENCE_NUMBER) ? INITIAL_SEQUENCE_NUMBER : sequenceNumber + 1);
+                        setLsaSequenceNumber(*newLSA, (sequenceNumber == MAX_SEQUENCE_NUMBER) ? INITIAL_SEQUENCE_NUMBER : sequenceNumber + 1);
                         shouldRebuildRoutingTable |= lsa->update(newLSA);
                         delete newLSA;
 
@@ -835,7 +832,7 @@ void Ospfv2Area::ageDatabase()
         associatedInterfaces[m]->ageTransmittedLsaLists();
 
     if (shouldRebuildRoutingTable)
-        parentRouter->rebuildRoutingTable();
+        parentRouter->requestRoutingTableRebuild();
 }
 
 bool Ospfv2Area::hasAnyNeighborInStates(int states) const
@@ -865,11 +862,13 @@ bool Ospfv2Area::isOnAnyRetransmissionList(LsaKeyType lsaKey) const
 bool Ospfv2Area::floodLSA(const Ospfv2Lsa *lsa, int current_ttl /* = -1 */, Ospfv2Interface *intf, Neighbor *neighbor)
 {
     bool floodedBackOut = false;
+    int fanout = 0;
     for (uint32_t i = 0; i < associatedInterfaces.size(); i++) {
-        if (associatedInterfaces[i]->floodLsa(lsa, current_ttl, intf, neighbor)) {
+        if (associatedInterfaces[i]->floodLsa(lsa, current_ttl, intf, neighbor, &fanout)) {
             floodedBackOut = true;
         }
     }
+    parentRouter->getOspfModule()->emit(Router::floodFanoutSignal, fanout);
     return floodedBackOut;
 }
 
@@ -1227,6 +1226,8 @@ LinkStateId Ospfv2Area::getUniqueLinkStateID(Ipv4AddressRange destination,
                 summaryLSA->getHeaderForUpdate().setLsSequenceNumber((sequenceNumber == MAX_SEQUENCE_NUMBER) ? INITIAL_SEQUENCE_NUMBER : sequenceNumber + 1);
                 summaryLSA->setNetworkMask(destination.mask);
                 summaryLSA->setRouteCost(destinationCost);
+                if (summaryLSA->getHeader().getLsCrcMode() == CRC_COMPUTED)
+                    setLsaCrc(*summaryLSA, CRC_COMPUTED);
 
                 lsaToReoriginate = summaryLSA;
 
@@ -1691,19 +1692,19 @@ void Ospfv2Area::sqsqCalculateShortestPathTree(RouterLsa *calculateRoot, RouterL
                         routingInfo->setDistance(linkStateCost);
                         routingInfo->clearNextHops();
                     }
-                    std::vector<NextHop> *newNextHops = calculateNextHops(treeRoot, joiningVertex, justAddedVertex); // (destination, parent)
-                    for (auto it = newNextHops->begin(); it != newNextHops->end(); ++it)
-                        routingInfo->addNextHop(*it);
-                    delete newNextHops;
+                    NextHopVector newNextHops;
+                    calculateNextHops(treeRoot, joiningVertex, justAddedVertex, newNextHops); // (destination, parent)
+                    for (uint32_t k = 0; k < newNextHops.size(); k++)
+                        routingInfo->addNextHop(newNextHops[k]);
                 }
                 else {
                     if (joiningVertexType == ROUTERLSA_TYPE) {
                         RouterLsa *joiningRouterVertex = check_and_cast<RouterLsa *>(joiningVertex);
                         joiningRouterVertex->setDistance(linkStateCost);
-                        std::vector<NextHop> *newNextHops = calculateNextHops(treeRoot, joiningVertex, justAddedVertex); // (destination, parent)
-                        for (auto it = newNextHops->begin(); it != newNextHops->end(); ++it)
-                            joiningRouterVertex->addNextHop(*it);
-                        delete newNextHops;
+                        NextHopVector newNextHops;
+                        calculateNextHops(treeRoot, joiningVertex, justAddedVertex, newNextHops); // (destination, parent)
+                        for (uint32_t k = 0; k < newNextHops.size(); k++)
+                            joiningRouterVertex->addNextHop(newNextHops[k]);
                         RoutingInfo *vertexRoutingInfo = check_and_cast<RoutingInfo *>(joiningRouterVertex);
                         vertexRoutingInfo->setParent(justAddedVertex);
 
@@ -1712,10 +1713,10 @@ void Ospfv2Area::sqsqCalculateShortestPathTree(RouterLsa *calculateRoot, RouterL
                     else { // @sqsq candidate == nullptr, i.e. it is the first round of iteration
                         NetworkLsa *joiningNetworkVertex = check_and_cast<NetworkLsa *>(joiningVertex);
                         joiningNetworkVertex->setDistance(linkStateCost);
-                        std::vector<NextHop> *newNextHops = calculateNextHops(treeRoot, joiningVertex, justAddedVertex); // (destination, parent)
-                        for (auto it = newNextHops->begin(); it != newNextHops->end(); ++it)
-                            joiningNetworkVertex->addNextHop(*it);
-                        delete newNextHops;
+                        NextHopVector newNextHops;
+                        calculateNextHops(treeRoot, joiningVertex, justAddedVertex, newNextHops); // (destination, parent)
+                        for (uint32_t k = 0; k < newNextHops.size(); k++)
+                            joiningNetworkVertex->addNextHop(newNextHops[k]);
                         RoutingInfo *vertexRoutingInfo = check_and_cast<RoutingInfo *>(joiningNetworkVertex);
                         vertexRoutingInfo->setParent(justAddedVertex);
 
@@ -1771,17 +1772,17 @@ void Ospfv2Area::sqsqCalculateShortestPathTree(RouterLsa *calculateRoot, RouterL
                         routingInfo->setDistance(linkStateCost);
                         routingInfo->clearNextHops();
                     }
-                    std::vector<NextHop> *newNextHops = calculateNextHops(treeRoot, joiningVertex, justAddedVertex); // (destination, parent)
-                    for (auto it = newNextHops->begin(); it != newNextHops->end(); ++it)
-                        routingInfo->addNextHop(*it);
-                    delete newNextHops;
+                    NextHopVector newNextHops;
+                    calculateNextHops(treeRoot, joiningVertex, justAddedVertex, newNextHops); // (destination, parent)
+                    for (uint32_t k = 0; k < newNextHops.size(); k++)
+                        routingInfo->addNextHop(newNextHops[k]);
                 }
                 else {
                     joiningVertex->setDistance(linkStateCost);
-                    std::vector<NextHop> *newNextHops = calculateNextHops(treeRoot, joiningVertex, justAddedVertex); // (destination, parent)
-                    for (auto it = newNextHops->begin(); it != newNextHops->end(); ++it)
-                        joiningVertex->addNextHop(*it);
-                    delete newNextHops;
+                    NextHopVector newNextHops;
+                    calculateNextHops(treeRoot, joiningVertex, justAddedVertex, newNextHops); // (destination, parent)
+                    for (uint32_t k = 0; k < newNextHops.size(); k++)
+                        joiningVertex->addNextHop(newNextHops[k]);
                     RoutingInfo *vertexRoutingInfo = check_and_cast<RoutingInfo *>(joiningVertex);
                     vertexRoutingInfo->setParent(justAddedVertex);
 
@@ -1829,7 +1830,7 @@ void Ospfv2Area::sqsqCalculateShortestPathTree(RouterLsa *calculateRoot, RouterL
             if (closestVertex->getHeader().getLsType() == ROUTERLSA_TYPE) {
                 RouterLsa *routerLSA = check_and_cast<RouterLsa *>(closestVertex);
                 if (routerLSA->getB_AreaBorderRouter() || routerLSA->getE_ASBoundaryRouter()) { // @sqsq: rfc2328 section 16.1(4) para 1, but our scheme has only 1 area, no ABR or ASBR
-                    Ospfv2RoutingTableEntry *entry = new Ospfv2RoutingTableEntry(ift);
+                    Ospfv2RoutingTableEntry *entry = parentRouter->getRoutingTableEntryPool().acquire();
                     RouterId destinationID = routerLSA->getHeader().getLinkStateID();
                     unsigned int nextHopCount = routerLSA->getNextHopCount();
                     Ospfv2RoutingTableEntry::RoutingDestinationType destinationType = Ospfv2RoutingTableEntry::NETWORK_DESTINATION;
@@ -1944,7 +1945,7 @@ void Ospfv2Area::sqsqCalculateShortestPathTree(RouterLsa *calculateRoot, RouterL
 
                 if ((entry == nullptr) || (overWrite)) {
                     if (entry == nullptr) { // @sqsq section 16.1 para 4
-                        entry = new Ospfv2RoutingTableEntry(ift);
+                        entry = parentRouter->getRoutingTableEntryPool().acquire();
                     }
 
                     entry->setDestination(Ipv4Address(destinationID));
@@ -2051,13 +2052,13 @@ void Ospfv2Area::sqsqCalculateShortestPathTree(RouterLsa *calculateRoot, RouterL
                         throw cRuntimeError("Can not cast class '%s' to RouterLsa or NetworkLsa", lsOrigin->getClassName());
                 }
 
-                std::vector<NextHop> *newNextHops = calculateNextHops(treeRoot, link, routerVertex); // (destination, parent)
-                for (auto it = newNextHops->begin(); it != newNextHops->end(); ++it)
-                    entry->addNextHop(*it);
-                delete newNextHops;
+                NextHopVector newNextHops;
+                calculateNextHops(treeRoot, link, routerVertex, newNextHops); // (destination, parent)
+                for (uint32_t k = 0; k < newNextHops.size(); k++)
+                    entry->addNextHop(newNextHops[k]);
             }
             else {
-                entry = new Ospfv2RoutingTableEntry(ift);
+                entry = parentRouter->getRoutingTableEntryPool().acquire();
 
                 entry->setDestination(Ipv4Address(destinationID));
                 entry->setNetmask(Ipv4Address(link.getLinkData()));
@@ -2067,10 +2068,10 @@ void Ospfv2Area::sqsqCalculateShortestPathTree(RouterLsa *calculateRoot, RouterL
                 entry->setCost(distance);
                 entry->setDestinationType(Ospfv2RoutingTableEntry::NETWORK_DESTINATION);
                 entry->setOptionalCapabilities(routerVertex->getHeader().getLsOptions());
-                std::vector<NextHop> *newNextHops = calculateNextHops(treeRoot, link, routerVertex); // (destination, parent)
-                for (auto it = newNextHops->begin(); it != newNextHops->end(); ++it)
-                    entry->addNextHop(*it);
-                delete newNextHops;
+                NextHopVector newNextHops;
+                calculateNextHops(treeRoot, link, routerVertex, newNextHops); // (destination, parent)
+                for (uint32_t k = 0; k < newNextHops.size(); k++)
+                    entry->addNextHop(newNextHops[k]);
 
                 newRoutingTable.push_back(entry);
             }
@@ -2089,13 +2090,7 @@ void Ospfv2Area::calculateShortestPathTree(std::vector<Ospfv2RoutingTableEntry *
      * router id: (0, 0, intra-orbit id, orbit id)
      * M: orbit number
      */
-    if (simTime() >= 100.0 && simTime() <= 106.0) {
-        if (parentRouter->getRouterID() == Ipv4Address(0, 0, 7, 5)) {
-            std::cout << simTime() << "： " << parentRouter->getRouterID() << endl;
-            sqsqPrintLSDB();
-            std::cout << "--------------------------" << endl;
-        }
-    }
+    // runs on a worker thread of the Ospfv2SpfWorkerPool if spfThreads > 0, it must not print or touch the simulation
 
     RouterId currentRouterID = parentRouter->getRouterID();
     RouterLsa *currentRouterLsa = findRouterLSA(currentRouterID);
@@ -2124,6 +2119,7 @@ void Ospfv2Area::calculateShortestPathTree(std::vector<Ospfv2RoutingTableEntry *
             int direction = getDirection(currentRouterID, joiningRouterLSA->getHeader().getLinkStateID());
 //            std::cout << "direction: " << direction << std::endl;
             selectedDirections.push_back(direction);
+            currentRouterLsa->setDistance(LS_INFINITY); // stays so if the neighbor cannot reach this router
             sqsqCalculateShortestPathTree(currentRouterLsa, joiningRouterLSA, routingTables[direction]);
 
             for (Ospfv2Interface *gatewayInterface : associatedInterfaces) {
@@ -2135,6 +2131,8 @@ void Ospfv2Area::calculateShortestPathTree(std::vector<Ospfv2RoutingTableEntry *
                     nextHop.advertisingRouter = currentRouterID; // is this true?
                     nextHop.hopAddress = nextHopAddr;
                     nextHop.ifIndex = gatewayInterface->getIfIndex();
+                    if (parentRouter->isFastRerouteEnabled())
+                        parentRouter->getFastReroute().setNeighborDistance(nextHop.ifIndex, link.getLinkCost(), currentRouterLsa->getDistance());
                     for (Ospfv2RoutingTableEntry *entry : routingTables[direction]) {
                         entry->clearNextHops();
                         entry->addNextHop(nextHop);
@@ -2183,16 +2181,16 @@ void Ospfv2Area::calculateShortestPathTree(std::vector<Ospfv2RoutingTableEntry *
 /*
  * @sqsq section 16.1.1
  */
-std::vector<NextHop> *Ospfv2Area::calculateNextHops(RouterLsa *treeRoot, Ospfv2Lsa *destination, Ospfv2Lsa *parent) const
+void Ospfv2Area::calculateNextHops(RouterLsa *treeRoot, Ospfv2Lsa *destination, Ospfv2Lsa *parent, NextHopVector& hops) const
 {
-    std::vector<NextHop> *hops = new std::vector<NextHop>; // @sqsq next hop: outgoing interface + IP of next hop router
+    hops.clear(); // @sqsq next hop: outgoing interface + IP of next hop router
 
     RouterLsa *routerLSA = dynamic_cast<RouterLsa *>(parent);
     if (routerLSA != nullptr) {
         if (routerLSA != treeRoot) {
             for (uint32_t i = 0; i < routerLSA->getNextHopCount(); i++)
-                hops->push_back(routerLSA->getNextHop(i));
-            return hops;
+                hops.push_back(routerLSA->getNextHop(i));
+            return;
         }
         else {
             RouterLsa *destinationRouterLSA = dynamic_cast<RouterLsa *>(destination);
@@ -2210,7 +2208,7 @@ std::vector<NextHop> *Ospfv2Area::calculateNextHops(RouterLsa *treeRoot, Ospfv2L
                                 nextHop.ifIndex = interface->getIfIndex();
                                 nextHop.hopAddress = ptpNeighbor->getAddress();
                                 nextHop.advertisingRouter = destinationRouterLSA->getHeader().getAdvertisingRouter();
-                                hops->push_back(nextHop);
+                                hops.push_back(nextHop);
                                 break;
                             }
                         }
@@ -2227,7 +2225,7 @@ std::vector<NextHop> *Ospfv2Area::calculateNextHops(RouterLsa *treeRoot, Ospfv2L
                                     nextHop.ifIndex = interface->getIfIndex();
                                     nextHop.hopAddress = Ipv4Address(link.getLinkData());
                                     nextHop.advertisingRouter = destinationRouterLSA->getHeader().getAdvertisingRouter();
-                                    hops->push_back(nextHop);
+                                    hops.push_back(nextHop);
                                 }
                             }
                             break;
@@ -2255,7 +2253,7 @@ std::vector<NextHop> *Ospfv2Area::calculateNextHops(RouterLsa *treeRoot, Ospfv2L
                             else
                                 nextHop.hopAddress = Ipv4Address::UNSPECIFIED_ADDRESS;
                             nextHop.advertisingRouter = destinationNetworkLSA->getHeader().getAdvertisingRouter();
-                            hops->push_back(nextHop);
+                            hops.push_back(nextHop);
                         }
                     }
                 }
@@ -2267,8 +2265,8 @@ std::vector<NextHop> *Ospfv2Area::calculateNextHops(RouterLsa *treeRoot, Ospfv2L
         if (networkLSA != nullptr) {
             if (networkLSA->getParent() != treeRoot) {
                 for (uint32_t i = 0; i < networkLSA->getNextHopCount(); i++)
-                    hops->push_back(networkLSA->getNextHop(i));
-                return hops;
+                    hops.push_back(networkLSA->getNextHop(i));
+                return;
             }
             else {
                 Ipv4Address parentLinkStateID = parent->getHeader().getLinkStateID();
@@ -2296,7 +2294,7 @@ std::vector<NextHop> *Ospfv2Area::calculateNextHops(RouterLsa *treeRoot, Ospfv2L
                                         nextHop.ifIndex = interface->getIfIndex();
                                         nextHop.hopAddress = nextHopNeighbor->getAddress();
                                         nextHop.advertisingRouter = destinationRouterLSA->getHeader().getAdvertisingRouter();
-                                        hops->push_back(nextHop);
+                                        hops.push_back(nextHop);
                                     }
                                 }
                             }
@@ -2306,19 +2304,17 @@ std::vector<NextHop> *Ospfv2Area::calculateNextHops(RouterLsa *treeRoot, Ospfv2L
             }
         }
     }
-
-    return hops;
 }
 
-std::vector<NextHop> *Ospfv2Area::calculateNextHops(RouterLsa *treeRoot, const Ospfv2Link& destination, Ospfv2Lsa *parent) const
+void Ospfv2Area::calculateNextHops(RouterLsa *treeRoot, const Ospfv2Link& destination, Ospfv2Lsa *parent, NextHopVector& hops) const
 {
-    std::vector<NextHop> *hops = new std::vector<NextHop>;
+    hops.clear();
 
     RouterLsa *routerLSA = check_and_cast<RouterLsa *>(parent);
     if (routerLSA != treeRoot) {
         for (uint32_t i = 0; i < routerLSA->getNextHopCount(); i++)
-            hops->push_back(routerLSA->getNextHop(i));
-        return hops;
+            hops.push_back(routerLSA->getNextHop(i));
+        return;
     }
     else {
         for (auto interface : associatedInterfaces) {
@@ -2341,7 +2337,7 @@ std::vector<NextHop> *Ospfv2Area::calculateNextHops(RouterLsa *treeRoot, const O
                         nextHop.ifIndex = interface->getIfIndex();
                         nextHop.hopAddress = neighborAddress;
                         nextHop.advertisingRouter = parentRouter->getRouterID();
-                        hops->push_back(nextHop);
+                        hops.push_back(nextHop);
                         break;
                     }
                 }
@@ -2359,7 +2355,7 @@ std::vector<NextHop> *Ospfv2Area::calculateNextHops(RouterLsa *treeRoot, const O
                     else
                         nextHop.hopAddress = Ipv4Address::UNSPECIFIED_ADDRESS;
                     nextHop.advertisingRouter = parentRouter->getRouterID();
-                    hops->push_back(nextHop);
+                    hops.push_back(nextHop);
                     break;
                 }
             }
@@ -2374,7 +2370,7 @@ std::vector<NextHop> *Ospfv2Area::calculateNextHops(RouterLsa *treeRoot, const O
                         nextHop.ifIndex = interface->getIfIndex();
                         nextHop.hopAddress = interface->getAddressRange().address;
                         nextHop.advertisingRouter = parentRouter->getRouterID();
-                        hops->push_back(nextHop);
+                        hops.push_back(nextHop);
                         break;
                     }
                 }
@@ -2385,7 +2381,7 @@ std::vector<NextHop> *Ospfv2Area::calculateNextHops(RouterLsa *treeRoot, const O
                         nextHop.ifIndex = interface->getIfIndex();
                         nextHop.hopAddress = neighbor->getAddress();
                         nextHop.advertisingRouter = parentRouter->getRouterID();
-                        hops->push_back(nextHop);
+                        hops.push_back(nextHop);
                         break;
                     }
                 }
@@ -2393,7 +2389,7 @@ std::vector<NextHop> *Ospfv2Area::calculateNextHops(RouterLsa *treeRoot, const O
             // next hops for virtual links are generated later, after examining transit areas' SummaryLSAs
         }
 
-        if (hops->size() == 0) {
+        if (hops.empty()) {
             for (uint32_t i = 0; i < hostRoutes.size(); i++) {
                 if ((destination.getLinkID() == hostRoutes[i].address) &&
                     (destination.getLinkData() == 0xFFFFFFFF))
@@ -2402,14 +2398,12 @@ std::vector<NextHop> *Ospfv2Area::calculateNextHops(RouterLsa *treeRoot, const O
                     nextHop.ifIndex = hostRoutes[i].ifIndex;
                     nextHop.hopAddress = hostRoutes[i].address;
                     nextHop.advertisingRouter = parentRouter->getRouterID();
-                    hops->push_back(nextHop);
+                    hops.push_back(nextHop);
                     break;
                 }
             }
         }
     }
-
-    return hops;
 }
 
 bool Ospfv2Area::hasLink(Ospfv2Lsa *fromLSA, Ospfv2Lsa *toLSA) const
@@ -2476,7 +2470,7 @@ bool Ospfv2Area::hasLink(Ospfv2Lsa *fromLSA, Ospfv2Lsa *toLSA) const
  * as the currentLSA. If a cheaper route is found then skip this LSA(return true), else
  * note those which are of equal or worse cost than the currentCost.
  */
-bool Ospfv2Area::findSameOrWorseCostRoute(const std::vector<Ospfv2RoutingTableEntry *>& newRoutingTable,
+bool Ospfv2Area::findSameOrWorseCostRoute(const Ospfv2RoutingTableIndex& newRoutingTable,
         const SummaryLsa& summaryLSA,
         unsigned short currentCost,
         bool& destinationInRoutingTable,
@@ -2489,7 +2483,10 @@ bool Ospfv2Area::findSameOrWorseCostRoute(const std::vector<Ospfv2RoutingTableEn
     destination.address = summaryLSA.getHeader().getLinkStateID();
     destination.mask = summaryLSA.getNetworkMask();
 
-    for (auto routingEntry : newRoutingTable) {
+    // both kinds of matching entries cover destination.address
+    std::vector<Ospfv2RoutingTableEntry *> matchingEntries;
+    newRoutingTable.findMatchingEntries(destination.address, matchingEntries);
+    for (auto routingEntry : matchingEntries) {
         bool foundMatching = false;
 
         if (summaryLSA.getHeader().getLsType() == SUMMARYLSA_NETWORKS_TYPE) {
@@ -2552,7 +2549,7 @@ Ospfv2RoutingTableEntry *Ospfv2Area::createRoutingTableEntryFromSummaryLSA(const
     destination.address = summaryLSA.getHeader().getLinkStateID();
     destination.mask = summaryLSA.getNetworkMask();
 
-    Ospfv2RoutingTableEntry *newEntry = new Ospfv2RoutingTableEntry(ift);
+    Ospfv2RoutingTableEntry *newEntry = parentRouter->getRoutingTableEntryPool().acquire();
 
     if (summaryLSA.getHeader().getLsType() == SUMMARYLSA_NETWORKS_TYPE) {
         newEntry->setDestination(destination.address & destination.mask);
@@ -2580,14 +2577,15 @@ Ospfv2RoutingTableEntry *Ospfv2Area::createRoutingTableEntryFromSummaryLSA(const
 
 /**
  * @see RFC 2328 Section 16.2.
- * @todo This function does a lot of lookup in the input newRoutingTable.
- *       Restructuring the input vector into some kind of hash would quite
- *       probably speed up execution.
+ * The lookups in the input newRoutingTable go through an Ospfv2RoutingTableIndex.
  */
 void Ospfv2Area::calculateInterAreaRoutes(std::vector<Ospfv2RoutingTableEntry *>& newRoutingTable)
 {
     printSummaryLsa();
 
+    Ospfv2RoutingTableIndex newRoutingTableIndex(newRoutingTable);
+    std::vector<Ospfv2RoutingTableEntry *> matchingEntries;
+
     for (uint32_t i = 0; i < summaryLSAs.size(); i++) {
         SummaryLsa *currentLSA = summaryLSAs[i];
         const Ospfv2LsaHeader& currentHeader = currentLSA->getHeader();
@@ -2602,7 +2600,6 @@ void Ospfv2Area::calculateInterAreaRoutes(std::vector<Ospfv2RoutingTableEntry *>
         }
 
         char lsType = currentHeader.getLsType();
-        unsigned long routeCount = newRoutingTable.size();
         Ipv4AddressRange destination;
 
         destination.address = currentHeader.getLinkStateID();
@@ -2611,8 +2608,8 @@ void Ospfv2Area::calculateInterAreaRoutes(std::vector<Ospfv2RoutingTableEntry *>
         if ((lsType == SUMMARYLSA_NETWORKS_TYPE) && (parentRouter->hasAddressRange(destination))) { // (3)
             // look for an "Active" INTRAAREA route
             bool foundIntraAreaRoute = false;
-            for (uint32_t j = 0; j < routeCount; j++) {
-                Ospfv2RoutingTableEntry *routingEntry = newRoutingTable[j];
+            newRoutingTableIndex.findMatchingEntries(destination.address, matchingEntries);
+            for (auto routingEntry : matchingEntries) {
                 if ((routingEntry->getDestinationType() == Ospfv2RoutingTableEntry::NETWORK_DESTINATION) &&
                     (routingEntry->getPathType() == Ospfv2RoutingTableEntry::INTRAAREA) &&
                     destination.containedByRange(routingEntry->getDestination(), routingEntry->getNetmask()))
@@ -2628,9 +2625,8 @@ void Ospfv2Area::calculateInterAreaRoutes(std::vector<Ospfv2RoutingTableEntry *>
         Ospfv2RoutingTableEntry *borderRouterEntry = nullptr;
 
         // The routingEntry describes a route to an other area -> look for the border router originating it
-        for (uint32_t j = 0; j < routeCount; j++) { // (4) N == destination, BR == borderRouterEntry
-            Ospfv2RoutingTableEntry *routingEntry = newRoutingTable[j];
-
+        newRoutingTableIndex.findMatchingEntries(originatingRouter, matchingEntries);
+        for (auto routingEntry : matchingEntries) { // (4) N == destination, BR == borderRouterEntry
             if ((routingEntry->getArea() == areaID) &&
                 (((routingEntry->getDestinationType() & Ospfv2RoutingTableEntry::AREA_BORDER_ROUTER_DESTINATION) != 0) ||
                  ((routingEntry->getDestinationType() & Ospfv2RoutingTableEntry::AS_BOUNDARY_ROUTER_DESTINATION) != 0)) &&
@@ -2651,7 +2647,7 @@ void Ospfv2Area::calculateInterAreaRoutes(std::vector<Ospfv2RoutingTableEntry *>
         unsigned short currentCost = routeCost + borderRouterEntry->getCost();
         std::list<Ospfv2RoutingTableEntry *> sameOrWorseCost;
 
-        if (findSameOrWorseCostRoute(newRoutingTable,
+        if (findSameOrWorseCostRoute(newRoutingTableIndex,
                 *currentLSA,
                 currentCost,
                 destinationInRoutingTable,
@@ -2669,13 +2665,8 @@ void Ospfv2Area::calculateInterAreaRoutes(std::vector<Ospfv2RoutingTableEntry *>
             // FIXME The code does not work according to the comment
             for (auto checkedEntry : sameOrWorseCost) {
                 if (checkedEntry->getCost() > currentCost) {
-                    for (auto entryIt = newRoutingTable.begin(); entryIt != newRoutingTable.end(); entryIt++) {
-                        if (checkedEntry == (*entryIt)) {
-                            delete *entryIt;
-                            newRoutingTable.erase(entryIt);
-                            break;
-                        }
-                    }
+                    if (newRoutingTableIndex.removeEntry(checkedEntry))
+                        parentRouter->getRoutingTableEntryPool().release(checkedEntry);
                 }
                 else { // EntryCost == currentCost
                     equalEntry = checkedEntry; // should be only one - if there are more they are ignored
@@ -2695,13 +2686,13 @@ void Ospfv2Area::calculateInterAreaRoutes(std::vector<Ospfv2RoutingTableEntry *>
             else {
                 Ospfv2RoutingTableEntry *newEntry = createRoutingTableEntryFromSummaryLSA(*currentLSA, currentCost, *borderRouterEntry);
                 ASSERT(newEntry != nullptr);
-                newRoutingTable.push_back(newEntry);
+                newRoutingTableIndex.addEntry(newEntry);
             }
         }
         else {
             Ospfv2RoutingTableEntry *newEntry = createRoutingTableEntryFromSummaryLSA(*currentLSA, currentCost, *borderRouterEntry);
             ASSERT(newEntry != nullptr);
-            newRoutingTable.push_back(newEntry);
+            newRoutingTableIndex.addEntry(newEntry);
         }
     }
 }
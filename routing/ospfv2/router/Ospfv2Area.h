@@ -16,6 +16,7 @@
 #include "inet/routing/ospfv2/router/Lsa.h"
 #include "inet/routing/ospfv2/router/Ospfv2Common.h"
 #include "inet/routing/ospfv2/router/Ospfv2RoutingTableEntry.h"
+#include "inet/routing/ospfv2/router/Ospfv2RoutingTableIndex.h"
 #include "inet/networklayer/contract/ipv4/Ipv4Address.h"
 
 namespace inet {
@@ -96,6 +97,7 @@ class INET_API Ospfv2Area : public cObject
     Ospfv2Interface *findVirtualLink(RouterId routerID);
 
     bool installRouterLSA(const Ospfv2RouterLsa *lsa);
+    bool storeRouterLSA(const Ospfv2RouterLsa *lsa); // installs the LSA as it is, without the link restoration of installRouterLSA()
     bool installNetworkLSA(const Ospfv2NetworkLsa *lsa);
     bool installSummaryLSA(const Ospfv2SummaryLsa *lsa);
     RouterLsa *findRouterLSA(LinkStateId linkStateID);
@@ -134,14 +136,14 @@ class INET_API Ospfv2Area : public cObject
   private:
     SummaryLsa *originateSummaryLSA(const SummaryLsa *summaryLSA);
     bool hasLink(Ospfv2Lsa *fromLSA, Ospfv2Lsa *toLSA) const;
-    std::vector<NextHop> *calculateNextHops(RouterLsa *treeRoot, Ospfv2Lsa *destination, Ospfv2Lsa *parent) const;
-    std::vector<NextHop> *calculateNextHops(RouterLsa *treeRoot, const Ospfv2Link& destination, Ospfv2Lsa *parent) const;
+    void calculateNextHops(RouterLsa *treeRoot, Ospfv2Lsa *destination, Ospfv2Lsa *parent, NextHopVector& hops) const;
+    void calculateNextHops(RouterLsa *treeRoot, const Ospfv2Link& destination, Ospfv2Lsa *parent, NextHopVector& hops) const;
 
     LinkStateId getUniqueLinkStateID(Ipv4AddressRange destination,
             Metric destinationCost,
             SummaryLsa *& lsaToReoriginate) const;
 
-    bool findSameOrWorseCostRoute(const std::vector<Ospfv2RoutingTableEntry *>& newRoutingTable,
+    bool findSameOrWorseCostRoute(const Ospfv2RoutingTableIndex& newRoutingTable,
             const SummaryLsa& currentLSA,
             unsigned short currentCost,
             bool& destinationInRoutingTable,
@@ -0,0 +1,88 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#include "inet/routing/ospfv2/router/Ospfv2FastReroute.h"
+
+#include <algorithm>
+
+namespace inet {
+namespace ospfv2 {
+
+void Ospfv2FastReroute::setNeighborDistance(int interfaceId, Metric linkCost, Metric distanceToSelf)
+{
+    NeighborDistance& neighborDistance = neighborDistances[interfaceId];
+    neighborDistance.linkCost = linkCost;
+    neighborDistance.distanceToSelf = distanceToSelf;
+}
+
+void Ospfv2FastReroute::computeRepairs(const std::vector<Ospfv2RoutingTableEntry *>& routes)
+{
+    repairsByInterface.clear();
+    unprotectedCount = 0;
+
+    std::map<std::pair<Ipv4Address, Ipv4Address>, std::vector<const Ospfv2RoutingTableEntry *>> routesByDestination;
+    for (auto route : routes)
+        routesByDestination[std::make_pair(route->getDestination(), route->getNetmask())].push_back(route);
+
+    for (auto& elem : routesByDestination) {
+        const auto& candidates = elem.second;
+        Metric primaryCost = LS_INFINITY;
+        for (auto route : candidates)
+            primaryCost = std::min(primaryCost, route->getCost());
+
+        std::vector<int> protectedInterfaceIds;
+        for (auto primary : candidates) {
+            if (primary->getCost() != primaryCost || primary->getInterface() == nullptr)
+                continue;
+            int primaryInterfaceId = primary->getInterface()->getInterfaceId();
+            if (std::find(protectedInterfaceIds.begin(), protectedInterfaceIds.end(), primaryInterfaceId) != protectedInterfaceIds.end())
+                continue;
+            protectedInterfaceIds.push_back(primaryInterfaceId);
+
+            // RFC 5286 3.1: the alternate through neighbor N is loop-free if dist(N, D) < dist(N, S) + dist(S, D)
+            const Ospfv2RoutingTableEntry *repair = nullptr;
+            for (auto alternate : candidates) {
+                if (alternate->getInterface() == nullptr || alternate->getInterface()->getInterfaceId() == primaryInterfaceId ||
+                    alternate->getGateway().isUnspecified() || alternate->getNextHopCount() == 0)
+                    continue;
+                auto it = neighborDistances.find(alternate->getInterface()->getInterfaceId());
+                if (it == neighborDistances.end() || alternate->getCost() < it->second.linkCost)
+                    continue;
+                Metric neighborToDestination = alternate->getCost() - it->second.linkCost;
+                if (neighborToDestination < it->second.distanceToSelf + primaryCost) {
+                    if (repair == nullptr || alternate->getCost() < repair->getCost())
+                        repair = alternate;
+                }
+            }
+
+            if (repair != nullptr)
+                repairsByInterface[primaryInterfaceId].push_back(*repair);
+            else
+                unprotectedCount++;
+        }
+    }
+}
+
+std::vector<Ospfv2RoutingTableEntry> Ospfv2FastReroute::takeRepairs(const NetworkInterface *failedInterface)
+{
+    std::vector<Ospfv2RoutingTableEntry> repairs;
+    auto it = repairsByInterface.find(failedInterface->getInterfaceId());
+    if (it != repairsByInterface.end()) {
+        repairs.swap(it->second);
+        repairsByInterface.erase(it);
+    }
+    return repairs;
+}
+
+size_t Ospfv2FastReroute::getRepairCount() const
+{
+    size_t count = 0;
+    for (auto& elem : repairsByInterface)
+        count += elem.second.size();
+    return count;
+}
+
+} // namespace ospfv2
+} // namespace inet
+
@@ -0,0 +1,81 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#ifndef __INET_OSPFV2FASTREROUTE_H
+#define __INET_OSPFV2FASTREROUTE_H
+
+#include <map>
+#include <vector>
+
+#include "inet/routing/ospfv2/router/Ospfv2RoutingTableEntry.h"
+
+namespace inet {
+
+namespace ospfv2 {
+
+/**
+ * IP fast reroute with loop-free alternates (RFC 5286) for the OSPF routes of
+ * a Router.
+ *
+ * The per-neighbor SPF calculation of the area already yields a route to each
+ * destination through every neighbor, together with the distance of the
+ * neighbor to this router. After each routing table rebuild, the alternate
+ * routes which satisfy the loop-free condition
+ *
+ *     distance(N, D) < distance(N, S) + distance(S, D)
+ *
+ * are selected as repairs for the primary route, grouped by the interface of
+ * the primary route. When that interface goes down, the Router removes the
+ * primary routes right away, so the alternates, which are installed with
+ * their own costs, take over without waiting for LSA origination and SPF.
+ * The Router postpones its routing table rebuilds by the fastRerouteSpfDelay
+ * parameter, then the rebuild installs the regular routes again.
+ */
+class INET_API Ospfv2FastReroute
+{
+  private:
+    struct NeighborDistance {
+        Metric linkCost = 0; // cost of the link from this router to the neighbor
+        Metric distanceToSelf = LS_INFINITY; // distance of the neighbor to this router
+    };
+
+    std::map<int, NeighborDistance> neighborDistances; // by interface id
+    std::map<int, std::vector<Ospfv2RoutingTableEntry>> repairsByInterface; // copies of the alternates by the interface id of the primary route
+    size_t unprotectedCount = 0;
+
+  public:
+    /**
+     * Forgets the neighbor distances of the previous SPF calculation.
+     */
+    void clearNeighborDistances() { neighborDistances.clear(); }
+
+    /**
+     * Records the distance of the neighbor reached through the interface to
+     * this router, as computed by the SPF calculation rooted at the neighbor.
+     */
+    void setNeighborDistance(int interfaceId, Metric linkCost, Metric distanceToSelf);
+
+    /**
+     * Selects the repairs for the routes that are installed in the IP routing
+     * table, replacing the previous ones.
+     */
+    void computeRepairs(const std::vector<Ospfv2RoutingTableEntry *>& routes);
+
+    /**
+     * Removes and returns the repairs of the routes that use the failed
+     * interface, i.e. copies of their alternate routes with all attributes.
+     * Repairs are applied at most once per computation.
+     */
+    std::vector<Ospfv2RoutingTableEntry> takeRepairs(const NetworkInterface *failedInterface);
+
+    size_t getRepairCount() const;
+    size_t getUnprotectedCount() const { return unprotectedCount; }
+};
+
+} // namespace ospfv2
+
+} // namespace inet
+
+#endif
+
@@ -0,0 +1,63 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#include "inet/routing/ospfv2/router/Ospfv2ResultFiles.h"
+
+#include <fstream>
+#include <map>
+#include <memory>
+
+#include "inet/common/SimulationScopedSingleton.h"
+#include "inet/routing/ospfv2/router/Ospfv2Common.h"
+
+namespace inet {
+
+namespace ospfv2 {
+
+namespace {
+
+class Ospfv2ResultFileRegistry : public SimulationScopedSingleton<Ospfv2ResultFileRegistry>
+{
+  protected:
+    // not before the network is deleted, the destructors of the modules may still write into the files
+    virtual void clear() override { files.clear(); }
+
+  public:
+    std::map<std::string, std::unique_ptr<std::ofstream>> files; // base name -> stream
+};
+
+} // namespace
+
+std::string Ospfv2ResultFiles::getFileName(const char *baseName)
+{
+    std::string filename = "/home/sqsq/Desktop/"
+            "sat-ospf/inet/examples/ospfv2/sqsqtest/results/";
+    filename += EXPERIMENT_NAME;
+    filename += "/";
+
+    filename += IS_OSPF ? "OSPF" : std::to_string(SQSQ_HOP);
+
+    filename += "/";
+    filename += getEnvir()->getConfigEx()->getActiveConfigName();
+    filename += "/";
+
+    std::string name = baseName;
+    if (getEnvir()->getParsimNumPartitions() > 1) {
+        auto extension = name.rfind('.');
+        name.insert(extension == std::string::npos ? name.length() : extension, "-" + std::to_string(getEnvir()->getParsimProcId()));
+    }
+    return filename + name;
+}
+
+std::ostream& Ospfv2ResultFiles::getFile(const char *baseName)
+{
+    auto& file = Ospfv2ResultFileRegistry::getInstance().files[baseName];
+    if (file == nullptr)
+        file.reset(new std::ofstream(getFileName(baseName), std::ios::app | std::ios::out));
+    return *file;
+}
+
+} // namespace ospfv2
+
+} // namespace inet
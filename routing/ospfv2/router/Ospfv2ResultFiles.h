@@ -0,0 +1,44 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#ifndef __INET_OSPFV2RESULTFILES_H
+#define __INET_OSPFV2RESULTFILES_H
+
+#include <ostream>
+#include <string>
+
+#include "inet/common/INETDefs.h"
+
+namespace inet {
+
+namespace ospfv2 {
+
+/*
+ * @sqsq
+ * The raw CSV result files of the satellite experiments (dropped packets,
+ * delivered packets, control overhead). All modules of the process append
+ * to one shared stream per file, which is opened on first use and closed
+ * after the network has been deleted. The partitions of a parallel
+ * simulation are separate processes, so each of them writes its own file:
+ * the partition id is inserted before the extension of the file name.
+ */
+class INET_API Ospfv2ResultFiles
+{
+  public:
+    /**
+     * Returns the path of the given result file of the active configuration.
+     */
+    static std::string getFileName(const char *baseName);
+
+    /**
+     * Returns the stream of the given result file, opened for appending.
+     */
+    static std::ostream& getFile(const char *baseName);
+};
+
+} // namespace ospfv2
+
+} // namespace inet
+
+#endif
@@ -6,28 +6,47 @@
 
 #include "inet/routing/ospfv2/router/Ospfv2Router.h"
 
+#include <chrono>
+
 #include "inet/common/stlutils.h"
 #include "inet/networklayer/ipv4/Ipv4InterfaceData.h"
+#include "inet/routing/ospfv2/Ospfv2Crc.h"
 #include "inet/routing/ospfv2/router/Lsa.h"
 
 namespace inet {
 
 namespace ospfv2 {
 
+simsignal_t Router::spfDurationSignal = cComponent::registerSignal("spfDuration");
+simsignal_t Router::lsdbSizeSignal = cComponent::registerSignal("lsdbSize");
+simsignal_t Router::lsaInstalledSignal = cComponent::registerSignal("lsaInstalled");
+simsignal_t Router::lsaRejectedSignal = cComponent::registerSignal("lsaRejected");
+simsignal_t Router::floodFanoutSignal = cComponent::registerSignal("floodFanout");
+simsignal_t Router::lsaRetransmittedSignal = cComponent::registerSignal("lsaRetransmitted");
+simsignal_t Router::routingTableChangesSignal = cComponent::registerSignal("routingTableChanges");
+
 Router::Router(cSimpleModule *containingModule, IInterfaceTable *ift, IIpv4RoutingTable *rt) :
+    ospfModule(containingModule),
     ift(ift),
     rt(rt),
     routerID(rt->getRouterId()),
+    routingTableIndex(ospfRoutingTable),
+    routingTableEntryPool(ift),
     rfc1583Compatibility(false)
 {
     messageHandler = new MessageHandler(this, containingModule);
     ageTimer = new cMessage("Router::DatabaseAgeTimer", DATABASE_AGE_TIMER);
     ageTimer->setContextPointer(this);
     messageHandler->startTimer(ageTimer, 1.0);
+    spfCommitTimer = new cMessage("Router::SpfCommitTimer");
+    spfCommitTimer->setContextPointer(this);
+    fastRerouteHoldTimer = new cMessage("Router::FastRerouteHoldTimer");
+    fastRerouteHoldTimer->setContextPointer(this);
 }
 
 Router::~Router()
 {
+    cancelRoutingTableRebuild();
     long areaCount = areas.size();
     for (long i = 0; i < areaCount; i++) {
         delete areas[i];
@@ -42,6 +61,8 @@ Router::~Router()
     }
     messageHandler->clearTimer(ageTimer);
     delete ageTimer;
+    ospfModule->cancelAndDelete(spfCommitTimer);
+    ospfModule->cancelAndDelete(fastRerouteHoldTimer);
     delete messageHandler;
 }
 
@@ -313,7 +334,7 @@ void Router::ageDatabase()
                 else {
                     AsExternalLsa *newLSA = originateASExternalLSA(lsa);
 
-                    newLSA->getHeaderForUpdate().setLsSequenceNumber(sequenceNumber + 1);
+                    setLsaSequenceNumber(*newLSA, sequenceNumber + 1);
                     shouldRebuildRoutingTable |= lsa->update(newLSA);
                     delete newLSA;
 
@@ -352,7 +373,7 @@ void Router::ageDatabase()
                         AsExternalLsa *newLSA = originateASExternalLSA(lsa);
                         long sequenceNumber = lsa->getHeader().getLsSequenceNumber();
 
-                        newLSA->getHeaderForUpdate().setLsSequenceNumber((sequenceNumber == MAX_SEQUENCE_NUMBER) ? INITIAL_SEQUENCE_NUMBER : sequenceNumber + 1);
+                        setLsaSequenceNumber(*newLSA, (sequenceNumber == MAX_SEQUENCE_NUMBER) ? INITIAL_SEQUENCE_NUMBER : sequenceNumber + 1);
                         shouldRebuildRoutingTable |= lsa->update(newLSA);
                         delete newLSA;
 
@@ -379,7 +400,7 @@ void Router::ageDatabase()
     messageHandler->startTimer(ageTimer, 1.0);
 
     if (shouldRebuildRoutingTable) {
-        rebuildRoutingTable();
+        requestRoutingTableRebuild();
     }
 }
 
@@ -592,40 +613,19 @@ bool Router::isDestinationUnreachable(Ospfv2Lsa *lsa) const
     return lookup(destination) == nullptr;
 }
 
-Ospfv2RoutingTableEntry *Router::lookup(Ipv4Address destination, std::vector<Ospfv2RoutingTableEntry *> *table /*= nullptr*/) const
+Ospfv2RoutingTableEntry *Router::lookup(Ipv4Address destination, const Ospfv2RoutingTableIndex *table /*= nullptr*/) const
 {
-    const std::vector<Ospfv2RoutingTableEntry *>& rTable = (table == nullptr) ? ospfRoutingTable : (*table);
-    bool unreachable = false;
-    std::vector<Ospfv2RoutingTableEntry *> discard;
-
-    for (uint32_t i = 0; i < areas.size(); i++) {
-        for (uint32_t j = 0; j < areas[i]->getAddressRangeCount(); j++) {
-            Ipv4AddressRange range = areas[i]->getAddressRange(j);
-            for (auto entry : rTable) {
-                if (entry->getDestinationType() != Ospfv2RoutingTableEntry::NETWORK_DESTINATION)
-                    continue;
-                if (range.containsRange(entry->getDestination(), entry->getNetmask()) &&
-                    (entry->getPathType() == Ospfv2RoutingTableEntry::INTRAAREA))
-                {
-                    // active area address range
-                    Ospfv2RoutingTableEntry *discardEntry = new Ospfv2RoutingTableEntry(ift);
-                    discardEntry->setDestination(range.address);
-                    discardEntry->setNetmask(range.mask);
-                    discardEntry->setDestinationType(Ospfv2RoutingTableEntry::NETWORK_DESTINATION);
-                    discardEntry->setPathType(Ospfv2RoutingTableEntry::INTERAREA);
-                    discardEntry->setArea(areas[i]->getAreaID());
-                    discard.push_back(discardEntry);
-                    break;
-                }
-            }
-        }
-    }
+    const Ospfv2RoutingTableIndex& tableIndex = (table == nullptr) ? routingTableIndex : (*table);
+    const std::vector<Ospfv2RoutingTableEntry *>& rTable = tableIndex.getTable();
 
     Ospfv2RoutingTableEntry *bestMatch = nullptr;
     unsigned long longestMatch = 0;
     unsigned long dest = destination.getInt();
 
-    for (auto entry : rTable) {
+    // only the entries covering the destination can match, the index returns them in table order
+    std::vector<Ospfv2RoutingTableEntry *> matchingEntries;
+    tableIndex.findMatchingEntries(destination, matchingEntries);
+    for (auto entry : matchingEntries) {
         if (entry->getDestinationType() != Ospfv2RoutingTableEntry::NETWORK_DESTINATION)
             continue;
         unsigned long entryAddress = entry->getDestination().getInt();
@@ -639,13 +639,24 @@ Ospfv2RoutingTableEntry *Router::lookup(Ipv4Address destination, std::vector<Osp
     }
 
     if (bestMatch == nullptr)
-        unreachable = true;
-    else {
-        for (auto entry : discard) {
-            unsigned long entryAddress = entry->getDestination().getInt();
-            unsigned long entryMask = entry->getNetmask().getInt();
-            if ((entryAddress & entryMask) == (dest & entryMask)) {
-                if ((dest & entryMask) > longestMatch) {
+        return nullptr;
+
+    // an active area address range (one that contains an intra-area network) discards the destinations
+    // it covers more specifically than the best match; the table is only scanned for these ranges
+    bool unreachable = false;
+    for (uint32_t i = 0; i < areas.size() && !unreachable; i++) {
+        for (uint32_t j = 0; j < areas[i]->getAddressRangeCount() && !unreachable; j++) {
+            Ipv4AddressRange range = areas[i]->getAddressRange(j);
+            unsigned long rangeAddress = range.address.getInt();
+            unsigned long rangeMask = range.mask.getInt();
+            if ((rangeAddress & rangeMask) != (dest & rangeMask) || (dest & rangeMask) <= longestMatch)
+                continue;
+            for (auto entry : rTable) {
+                if (entry->getDestinationType() != Ospfv2RoutingTableEntry::NETWORK_DESTINATION)
+                    continue;
+                if (range.containsRange(entry->getDestination(), entry->getNetmask()) &&
+                    (entry->getPathType() == Ospfv2RoutingTableEntry::INTRAAREA))
+                {
                     unreachable = true;
                     break;
                 }
@@ -653,9 +664,6 @@ Ospfv2RoutingTableEntry *Router::lookup(Ipv4Address destination, std::vector<Osp
         }
     }
 
-    for (uint32_t i = 0; i < discard.size(); i++)
-        delete discard[i];
-
     if (unreachable)
         return nullptr;
     else
@@ -664,19 +672,137 @@ Ospfv2RoutingTableEntry *Router::lookup(Ipv4Address destination, std::vector<Osp
 
 void Router::rebuildRoutingTable()
 {
-    unsigned long areaCount = areas.size();
-    bool hasTransitAreas = false;
+    // a calculation running in the background is based on an older database
+    cancelRoutingTableRebuild();
+
     std::vector<Ospfv2RoutingTableEntry *> newTable;
+    auto calculationStart = std::chrono::steady_clock::now();
 
     EV_INFO << "--> Rebuilding routing table:\n";
 
+    calculateRoutingTable(newTable);
+    installRoutingTable(newTable, std::chrono::duration<double>(std::chrono::steady_clock::now() - calculationStart).count());
+}
+
+void Router::requestRoutingTableRebuild()
+{
+    if (fastRerouteHoldTimer->isScheduled()) {
+        EV_INFO << "--> Routing table rebuild postponed, loop-free alternates are in use\n";
+        return;
+    }
+
+    if (spfWorkerPool == nullptr) {
+        rebuildRoutingTable();
+        return;
+    }
+
+    // the newer request supersedes the one still running
+    cancelRoutingTableRebuild();
+
+    EV_INFO << "--> Rebuilding routing table in the background\n";
+    pendingCalculation = spfWorkerPool->submit([this] () {
+        auto calculationStart = std::chrono::steady_clock::now();
+        calculateRoutingTable(pendingTable);
+        pendingCalculationDuration = std::chrono::duration<double>(std::chrono::steady_clock::now() - calculationStart).count();
+    });
+    // events already scheduled for the current time run in parallel with the calculation;
+    // not a protocol timer, it must stay a separate event even if the timers are coalesced
+    ospfModule->scheduleAfter(0, spfCommitTimer);
+}
+
+void Router::finishRoutingTableRebuild()
+{
+    if (!pendingCalculation.valid())
+        return;
+    pendingCalculation.get();
+    ospfModule->cancelEvent(spfCommitTimer);
+    std::vector<Ospfv2RoutingTableEntry *> newTable;
+    newTable.swap(pendingTable);
+    installRoutingTable(newTable, pendingCalculationDuration);
+}
+
+int Router::applyFastReroute(const NetworkInterface *failedInterface)
+{
+    if (!fastRerouteEnabled)
+        return 0;
+
+    // the primary routes through the failed interface are removed from both tables;
+    // the alternates are normally installed already with their own costs, as the
+    // routes through the other neighbors, otherwise they are installed here
+    std::map<std::pair<Ipv4Address, Ipv4Address>, const Ospfv2RoutingTableEntry *> alternates; // by destination and netmask
+    std::vector<Ospfv2RoutingTableEntry> repairs = fastReroute.takeRepairs(failedInterface);
+    for (auto& repair : repairs) {
+        NetworkInterface *repairInterface = ift->getInterfaceById(repair.getNextHop(0).ifIndex);
+        if (repairInterface == nullptr || !repairInterface->isUp())
+            continue;
+        alternates[std::make_pair(repair.getDestination(), repair.getNetmask())] = &repair;
+        std::vector<Ospfv2RoutingTableEntry *> matchingEntries;
+        routingTableIndex.findMatchingEntries(repair.getDestination(), matchingEntries);
+        for (auto entry : matchingEntries) {
+            if (entry->getDestination() == repair.getDestination() && entry->getNetmask() == repair.getNetmask() &&
+                entry->getInterface() == failedInterface)
+                deleteRoute(entry);
+        }
+    }
+    int promotedCount = alternates.size();
+    if (promotedCount == 0)
+        return 0;
+
+    rt->beginUpdate();
+    for (int32_t i = rt->getNumRoutes() - 1; i >= 0; i--) {
+        Ospfv2RoutingTableEntry *route = dynamic_cast<Ospfv2RoutingTableEntry *>(rt->getRoute(i));
+        if (route == nullptr)
+            continue;
+        auto it = alternates.find(std::make_pair(route->getDestination(), route->getNetmask()));
+        if (it == alternates.end())
+            continue;
+        if (route->getInterface() == failedInterface)
+            rt->deleteRoute(route);
+        else if (*route == *it->second)
+            alternates.erase(it);
+    }
+    for (auto& elem : alternates)
+        rt->addRoute(new Ospfv2RoutingTableEntry(*elem.second));
+    rt->commitUpdate();
+
+    if (!fastRerouteHoldTimer->isScheduled())
+        ospfModule->scheduleAfter(fastRerouteSpfDelay, fastRerouteHoldTimer);
+    return promotedCount;
+}
+
+void Router::finishFastReroute()
+{
+    // the rebuilds requested while the timer was scheduled were dropped
+    requestRoutingTableRebuild();
+}
+
+void Router::cancelRoutingTableRebuild()
+{
+    if (!pendingCalculation.valid())
+        return;
+    try {
+        pendingCalculation.get();
+    }
+    catch (...) {
+        // the result is not needed anyway
+    }
+    ospfModule->cancelEvent(spfCommitTimer);
+    routingTableEntryPool.releaseAll(pendingTable);
+}
+
+void Router::calculateRoutingTable(std::vector<Ospfv2RoutingTableEntry *>& newTable)
+{
+    unsigned long areaCount = areas.size();
+    bool hasTransitAreas = false;
+
+    if (fastRerouteEnabled)
+        fastReroute.clearNeighborDistances();
     for (uint32_t i = 0; i < areaCount; i++) {
         areas[i]->calculateShortestPathTree(newTable);
         if (areas[i]->getTransitCapability())
             hasTransitAreas = true;
     }
 
-    simtime_t t1 = simTime();
     if (areaCount > 1) {
         Ospfv2Area *backbone = getAreaByID(BACKBONE_AREAID);
         // if this is an ABR and at least one adjacency in FULL state is built over the backbone
@@ -698,6 +824,11 @@ void Router::rebuildRoutingTable()
     }
 
     calculateASExternalRoutes(newTable);
+}
+
+void Router::installRoutingTable(std::vector<Ospfv2RoutingTableEntry *>& newTable, double calculationDuration)
+{
+    auto installStart = std::chrono::steady_clock::now();
 
     // backup the routing table
     std::vector<Ospfv2RoutingTableEntry *> oldTable;
@@ -705,6 +836,7 @@ void Router::rebuildRoutingTable()
 
     ospfRoutingTable.clear();
     ospfRoutingTable.assign(newTable.begin(), newTable.end());
+    routingTableIndex.rebuild();
 
     // remove entries from the Ipv4 routing table inserted by the OSPF module
     std::vector<Ipv4Route *> eraseEntries;
@@ -715,32 +847,36 @@ void Router::rebuildRoutingTable()
             eraseEntries.push_back(entry);
     }
 
-    // add the new routing entries
-    std::vector<Ipv4Route *> addEntries;
+    // collect the new routing entries; they are only cloned into the Ipv4 table if not already there
+    std::vector<Ospfv2RoutingTableEntry *> addEntries;
     for (auto& tableEntry : ospfRoutingTable) {
         if (tableEntry->getDestinationType() == Ospfv2RoutingTableEntry::NETWORK_DESTINATION) {
             // OSPF never adds direct routes into the IP routing table
             if (!isDirectRoute(*tableEntry)) {
                 // ignore advertised loopback addresses with dest=gateway
-                if (tableEntry->getDestination() != tableEntry->getGateway()) {
-                    Ipv4Route *entry = new Ospfv2RoutingTableEntry(*tableEntry);
-                    addEntries.push_back(entry);
-                }
+                if (tableEntry->getDestination() != tableEntry->getGateway())
+                    addEntries.push_back(tableEntry);
             }
         }
     }
 
-    // find the difference between two tables
-    std::vector<Ipv4Route *> diffAddEntries;
+    if (fastRerouteEnabled) {
+        fastReroute.computeRepairs(addEntries);
+        EV_DETAIL << "Fast reroute: " << fastReroute.getRepairCount() << " loop-free alternates, "
+                  << fastReroute.getUnprotectedCount() << " unprotected routes\n";
+    }
+
+    // find the difference between two tables; a route is only kept if all its OSPF attributes
+    // (path type, area, costs, origin, all next hops) are the same, as others read them from the Ipv4 table (e.g. Bgp)
+    std::vector<Ospfv2RoutingTableEntry *> diffAddEntries;
     std::vector<Ipv4Route *> diffEraseEntries;
     diffEraseEntries.assign(eraseEntries.begin(), eraseEntries.end());
     for (auto& entry : addEntries) {
         auto position = std::find_if(diffEraseEntries.begin(), diffEraseEntries.end(), [&] (const Ipv4Route *m) -> bool {
-            return (m->getDestination() == entry->getDestination()) &&
-                   (m->getNetmask() == entry->getNetmask()) &&
-                   (m->getInterface()->getInterfaceId() == entry->getInterface()->getInterfaceId()) &&
+            return (m->getInterface()->getInterfaceId() == entry->getInterface()->getInterfaceId()) &&
                    (m->getGateway() == entry->getGateway()) &&
-                   (m->getMetric() == entry->getMetric());
+                   (m->getMetric() == entry->getMetric()) &&
+                   (*check_and_cast<const Ospfv2RoutingTableEntry *>(m) == *entry);
         });
         if (position != diffEraseEntries.end())
             diffEraseEntries.erase(position);
@@ -759,36 +895,49 @@ void Router::rebuildRoutingTable()
         EV_INFO << "No changes to the OSPF routing table. \n";
     }
 
-    for (auto& entry : eraseEntries)
+    // unchanged routes stay in the Ipv4 table, only the difference is applied in a single update
+    rt->beginUpdate();
+    for (auto& entry : diffEraseEntries)
         rt->deleteRoute(entry);
 
-    for (auto& entry : addEntries)
-        rt->addRoute(entry);
+    for (auto& entry : diffAddEntries)
+        rt->addRoute(new Ospfv2RoutingTableEntry(*entry));
+    rt->commitUpdate();
 
     EV_INFO << "<-- Routing table was rebuilt.\n"
             << "Results:\n";
 
     notifyAboutRoutingTableChanges(oldTable);
 
-    for (auto& entry : oldTable)
-        delete entry;
+    routingTableEntryPool.releaseAll(oldTable);
+
+    ospfModule->emit(routingTableChangesSignal, diffEraseEntries.size() + diffAddEntries.size());
+    ospfModule->emit(lsdbSizeSignal, getLsdbSize());
+    ospfModule->emit(spfDurationSignal, calculationDuration + std::chrono::duration<double>(std::chrono::steady_clock::now() - installStart).count());
+}
+
+unsigned long Router::getLsdbSize() const
+{
+    unsigned long lsaCount = asExternalLSAs.size();
+    for (auto area : areas)
+        lsaCount += area->getRouterLSACount() + area->getNetworkLSACount() + area->getSummaryLSACount();
+    return lsaCount;
 }
 
 bool Router::deleteRoute(Ospfv2RoutingTableEntry *entry)
 {
-    auto i = find(ospfRoutingTable, entry);
-    if (i != ospfRoutingTable.end()) {
-        delete *i;
-        ospfRoutingTable.erase(i);
+    if (routingTableIndex.removeEntry(entry)) {
+        routingTableEntryPool.release(entry);
         return true;
     }
     return false;
 }
 
-bool Router::hasRouteToASBoundaryRouter(const std::vector<Ospfv2RoutingTableEntry *>& inRoutingTable, RouterId asbrRouterID) const
+bool Router::hasRouteToASBoundaryRouter(const Ospfv2RoutingTableIndex& inRoutingTable, RouterId asbrRouterID) const
 {
-    for (uint32_t i = 0; i < inRoutingTable.size(); i++) {
-        Ospfv2RoutingTableEntry *routingEntry = inRoutingTable[i];
+    std::vector<Ospfv2RoutingTableEntry *> matchingEntries;
+    inRoutingTable.findMatchingEntries(asbrRouterID, matchingEntries);
+    for (auto routingEntry : matchingEntries) {
         if (routingEntry->getDestination() == (asbrRouterID & routingEntry->getNetmask())) {
             if (!routingEntry->getGateway().isUnspecified())
                 return true;
@@ -812,11 +961,12 @@ bool Router::hasRouteToASBoundaryRouter(const std::vector<Ospfv2RoutingTableEntr
     return false;
 }
 
-std::vector<Ospfv2RoutingTableEntry *> Router::getRoutesToASBoundaryRouter(const std::vector<Ospfv2RoutingTableEntry *>& fromRoutingTable, RouterId asbrRouterID) const
+std::vector<Ospfv2RoutingTableEntry *> Router::getRoutesToASBoundaryRouter(const Ospfv2RoutingTableIndex& fromRoutingTable, RouterId asbrRouterID) const
 {
     std::vector<Ospfv2RoutingTableEntry *> results;
-    for (uint32_t i = 0; i < fromRoutingTable.size(); i++) {
-        Ospfv2RoutingTableEntry *routingEntry = fromRoutingTable[i];
+    std::vector<Ospfv2RoutingTableEntry *> matchingEntries;
+    fromRoutingTable.findMatchingEntries(asbrRouterID, matchingEntries);
+    for (auto routingEntry : matchingEntries) {
         if (routingEntry->getDestination() == (asbrRouterID & routingEntry->getNetmask())) {
             if (!routingEntry->getGateway().isUnspecified())
                 results.push_back(routingEntry);
@@ -887,11 +1037,11 @@ Ospfv2RoutingTableEntry *Router::selectLeastCostRoutingEntry(std::vector<Ospfv2R
     return leastCostEntry;
 }
 
-Ospfv2RoutingTableEntry *Router::getPreferredEntry(const Ospfv2Lsa& lsa, bool skipSelfOriginated, std::vector<Ospfv2RoutingTableEntry *> *fromRoutingTable /*= nullptr*/)
+Ospfv2RoutingTableEntry *Router::getPreferredEntry(const Ospfv2Lsa& lsa, bool skipSelfOriginated, const Ospfv2RoutingTableIndex *fromRoutingTable /*= nullptr*/)
 {
     // see RFC 2328 16.3. and 16.4.
     if (fromRoutingTable == nullptr)
-        fromRoutingTable = &ospfRoutingTable;
+        fromRoutingTable = &routingTableIndex;
 
     const Ospfv2LsaHeader& lsaHeader = lsa.getHeader();
     const Ospfv2AsExternalLsa *asExternalLSA = dynamic_cast<const Ospfv2AsExternalLsa *>(&lsa);
@@ -947,23 +1097,25 @@ void Router::calculateASExternalRoutes(std::vector<Ospfv2RoutingTableEntry *>& n
 
     printAsExternalLsa();
 
+    Ospfv2RoutingTableIndex newRoutingTableIndex(newRoutingTable);
+
     for (uint32_t i = 0; i < asExternalLSAs.size(); i++) {
         AsExternalLsa *currentLSA = asExternalLSAs[i];
         const Ospfv2LsaHeader& currentHeader = currentLSA->getHeader();
         unsigned short externalCost = currentLSA->getContents().getExternalTOSInfo(0).routeCost;
         RouterId originatingRouter = currentHeader.getAdvertisingRouter();
 
-        Ospfv2RoutingTableEntry *preferredEntry = getPreferredEntry(*currentLSA, true, &newRoutingTable);
+        Ospfv2RoutingTableEntry *preferredEntry = getPreferredEntry(*currentLSA, true, &newRoutingTableIndex);
         if (!preferredEntry)
             continue;
 
         Ipv4Address destination = currentHeader.getLinkStateID() & currentLSA->getContents().getNetworkMask();
 
         Metric preferredCost = preferredEntry->getCost();
-        Ospfv2RoutingTableEntry *destinationEntry = lookup(destination, &newRoutingTable); // (5)
+        Ospfv2RoutingTableEntry *destinationEntry = lookup(destination, &newRoutingTableIndex); // (5)
         if (destinationEntry == nullptr) {
             bool type2ExternalMetric = currentLSA->getContents().getExternalTOSInfo(0).E_ExternalMetricType;
-            Ospfv2RoutingTableEntry *newEntry = new Ospfv2RoutingTableEntry(ift);
+            Ospfv2RoutingTableEntry *newEntry = routingTableEntryPool.acquire();
 
             newEntry->setDestination(destination);
             newEntry->setNetmask(currentLSA->getContents().getNetworkMask());
@@ -988,7 +1140,7 @@ void Router::calculateASExternalRoutes(std::vector<Ospfv2RoutingTableEntry *>& n
                 }
             }
 
-            newRoutingTable.push_back(newEntry);
+            newRoutingTableIndex.addEntry(newEntry);
         }
         else {
             Ospfv2RoutingTableEntry::RoutingPathType destinationPathType = destinationEntry->getPathType();
@@ -1010,7 +1162,7 @@ void Router::calculateASExternalRoutes(std::vector<Ospfv2RoutingTableEntry *>& n
                 continue;
             }
 
-            Ospfv2RoutingTableEntry *destinationPreferredEntry = getPreferredEntry(*(destinationEntry->getLinkStateOrigin()), false, &newRoutingTable);
+            Ospfv2RoutingTableEntry *destinationPreferredEntry = getPreferredEntry(*(destinationEntry->getLinkStateOrigin()), false, &newRoutingTableIndex);
             if ((!rfc1583Compatibility) &&
                 (destinationPreferredEntry->getPathType() == Ospfv2RoutingTableEntry::INTRAAREA) &&
                 (destinationPreferredEntry->getArea() != BACKBONE_AREAID) &&
@@ -1126,6 +1278,8 @@ LinkStateId Router::getUniqueLinkStateID(const Ipv4AddressRange& destination,
             asExternalLSA->getContentsForUpdate().setNetworkMask(destination.mask);
             asExternalLSA->getContentsForUpdate().getExternalTOSInfoForUpdate(0).E_ExternalMetricType = externalMetricIsType2;
             asExternalLSA->getContentsForUpdate().getExternalTOSInfoForUpdate(0).routeCost = destinationCost;
+            if (asExternalLSA->getHeader().getLsCrcMode() == CRC_COMPUTED)
+                setLsaCrc(*asExternalLSA, CRC_COMPUTED);
 
             lsaToReoriginate = asExternalLSA;
 
@@ -1218,7 +1372,7 @@ void Router::notifyAboutRoutingTableChanges(std::vector<Ospfv2RoutingTableEntry
                          */
                         int32_t sequenceNumber = newLSA->getHeader().getLsSequenceNumber();
                         if (sequenceNumber != MAX_SEQUENCE_NUMBER)
-                            newLSA->getHeaderForUpdate().setLsSequenceNumber(sequenceNumber + 1);
+                            setLsaSequenceNumber(*newLSA, sequenceNumber + 1);
 
                         areas[i]->installSummaryLSA(newLSA);
                         floodLSA(newLSA, areas[i]->getAreaID());
@@ -1410,7 +1564,7 @@ void Router::updateExternalRoute(Ipv4Address networkAddress, const Ospfv2AsExter
     delete asExternalLSA;
 
     if (rebuild)
-        rebuildRoutingTable();
+        requestRoutingTableRebuild();
 }
 
 void Router::addExternalRouteInIPTable(Ipv4Address networkAddress, const Ospfv2AsExternalLsaContents& externalRouteContents, int ifIndex)
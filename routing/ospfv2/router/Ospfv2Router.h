@@ -7,6 +7,7 @@
 #ifndef __INET_OSPFV2ROUTER_H
 #define __INET_OSPFV2ROUTER_H
 
+#include <future>
 #include <map>
 #include <vector>
 
@@ -15,7 +16,11 @@
 #include "inet/routing/ospfv2/router/Lsa.h"
 #include "inet/routing/ospfv2/router/Ospfv2Area.h"
 #include "inet/routing/ospfv2/router/Ospfv2Common.h"
+#include "inet/routing/ospfv2/router/Ospfv2FastReroute.h"
 #include "inet/routing/ospfv2/router/Ospfv2RoutingTableEntry.h"
+#include "inet/routing/ospfv2/router/Ospfv2RoutingTableEntryPool.h"
+#include "inet/routing/ospfv2/router/Ospfv2RoutingTableIndex.h"
+#include "inet/routing/ospfv2/router/Ospfv2SpfWorkerPool.h"
 
 namespace inet {
 
@@ -30,6 +35,7 @@ namespace ospfv2 {
 class INET_API Router
 {
   private:
+    cSimpleModule *ospfModule = nullptr; ///< The containing Ospfv2 module - emits the statistics signals.
     IInterfaceTable *ift = nullptr;
     IIpv4RoutingTable *rt = nullptr;
     RouterId routerID; ///< The router ID assigned by the IP layer.
@@ -40,8 +46,29 @@ class INET_API Router
     std::map<Ipv4Address, Ospfv2AsExternalLsaContents> externalRoutes; ///< A map of the external route advertised by this router.
     cMessage *ageTimer; ///< Database age timer - fires every second.
     std::vector<Ospfv2RoutingTableEntry *> ospfRoutingTable; ///< The OSPF routing table - contains more information than the one in the IP layer.
+    Ospfv2RoutingTableIndex routingTableIndex; ///< Destination index of ospfRoutingTable.
+    Ospfv2RoutingTableEntryPool routingTableEntryPool; ///< Recycles routing table entries between rebuilds.
+    Ospfv2FastReroute fastReroute; ///< Loop-free alternates of the routes, promoted when an interface goes down.
     MessageHandler *messageHandler; ///< The message dispatcher class.
     bool rfc1583Compatibility; ///< Decides whether to handle the preferred routing table entry to an AS boundary router as defined in RFC1583 or not.
+    Ospfv2SpfWorkerPool *spfWorkerPool = nullptr; ///< Runs the routing table calculations in the background if set.
+    cMessage *spfCommitTimer = nullptr; ///< Installs the routing table calculated in the background - fires at the time of the request.
+    std::future<void> pendingCalculation; ///< The routing table calculation running in the background, if any.
+    std::vector<Ospfv2RoutingTableEntry *> pendingTable; ///< The result of the background calculation.
+    double pendingCalculationDuration = 0; ///< Wall-clock duration of the background calculation in seconds.
+    bool fastRerouteEnabled = false; ///< Whether loop-free alternates are computed and promoted.
+    simtime_t fastRerouteSpfDelay; ///< How long the routing table calculation is postponed after loop-free alternates were promoted.
+    cMessage *fastRerouteHoldTimer = nullptr; ///< Rebuilds the routing table after fastRerouteSpfDelay - no rebuild runs while it is scheduled.
+
+  public:
+    // control plane statistics, see Ospfv2.ned
+    static simsignal_t spfDurationSignal; ///< Wall-clock duration of a routing table calculation in seconds.
+    static simsignal_t lsdbSizeSignal; ///< Number of LSAs in the databases after a routing table calculation.
+    static simsignal_t lsaInstalledSignal; ///< Hop limit (flooding scope) of a received LSA that was installed.
+    static simsignal_t lsaRejectedSignal; ///< Hop limit (flooding scope) of a received LSA that was not installed.
+    static simsignal_t floodFanoutSignal; ///< Number of neighbors an LSA was flooded to within an area.
+    static simsignal_t lsaRetransmittedSignal; ///< Number of LSAs in a retransmitted Link State Update packet.
+    static simsignal_t routingTableChangesSignal; ///< Number of routes added to and removed from the IP routing table.
 
   public:
     /**
@@ -73,7 +100,11 @@ class INET_API Router
     unsigned long getRoutingTableEntryCount() const { return ospfRoutingTable.size(); }
     Ospfv2RoutingTableEntry *getRoutingTableEntry(unsigned long i) { return ospfRoutingTable[i]; }
     const Ospfv2RoutingTableEntry *getRoutingTableEntry(unsigned long i) const { return ospfRoutingTable[i]; }
-    void addRoutingTableEntry(Ospfv2RoutingTableEntry *entry) { ospfRoutingTable.push_back(entry); }
+    void addRoutingTableEntry(Ospfv2RoutingTableEntry *entry) { routingTableIndex.addEntry(entry); }
+    Ospfv2RoutingTableEntryPool& getRoutingTableEntryPool() { return routingTableEntryPool; }
+    Ospfv2FastReroute& getFastReroute() { return fastReroute; }
+    void setFastReroute(bool enabled, simtime_t spfDelay) { fastRerouteEnabled = enabled; fastRerouteSpfDelay = spfDelay; }
+    bool isFastRerouteEnabled() const { return fastRerouteEnabled; }
 
     /**
      * Adds OMNeT++ watches for the routerID, the list of Areas and the list of AS External LSAs.
@@ -190,10 +221,10 @@ class INET_API Router
      * Do a lookup in either the input OSPF routing table, or if it's nullptr then in the Router's own routing table.
      * @sa RFC2328 Section 11.1.
      * @param destination [in] The destination to look up in the routing table.
-     * @param table       [in] The routing table to do the lookup in.
+     * @param table       [in] The index of the routing table to do the lookup in.
      * @return The RoutingTableEntry describing the input destination if there's one, false otherwise.
      */
-    Ospfv2RoutingTableEntry *lookup(Ipv4Address destination, std::vector<Ospfv2RoutingTableEntry *> *table = nullptr) const;
+    Ospfv2RoutingTableEntry *lookup(Ipv4Address destination, const Ospfv2RoutingTableIndex *table = nullptr) const;
 
     /**
      * Rebuilds the routing table from scratch(based on the LSA database).
@@ -201,6 +232,41 @@ class INET_API Router
      */
     void rebuildRoutingTable();
 
+    /**
+     * Rebuilds the routing table in response to a protocol event. Without a
+     * worker pool this is the same as rebuildRoutingTable(). Otherwise the
+     * calculation is started in the background and its result is installed by
+     * the spfCommitTimer, scheduled for the current simulation time, or
+     * earlier by finishRoutingTableRebuild().
+     */
+    void requestRoutingTableRebuild();
+
+    /**
+     * Waits for the routing table calculation running in the background and
+     * installs its result. Must be called before the router is touched in any
+     * way, as the calculation works on the LSA database.
+     */
+    void finishRoutingTableRebuild();
+
+    void setSpfWorkerPool(Ospfv2SpfWorkerPool *pool) { spfWorkerPool = pool; }
+    cMessage *getSpfCommitTimer() { return spfCommitTimer; }
+
+    /**
+     * Promotes the loop-free alternates of the routes through the failed
+     * interface by removing those routes from the OSPF and the IP routing
+     * table in a single update, and if there were any, postpones the rebuilds
+     * by fastRerouteSpfDelay, so that the rebuild triggered by the interface
+     * going down does not replace the alternates in the same event. Returns
+     * the number of promoted routes.
+     */
+    int applyFastReroute(const NetworkInterface *failedInterface);
+
+    /**
+     * Rebuilds the routing table postponed by applyFastReroute().
+     */
+    void finishFastReroute();
+    cMessage *getFastRerouteHoldTimer() { return fastRerouteHoldTimer; }
+
     // delete an entry from the OSPF routing table
     bool deleteRoute(Ospfv2RoutingTableEntry *entry);
 
@@ -254,21 +320,28 @@ class INET_API Router
      *                                the preferred Routing Entry is sought for.
      * @param skipSelfOriginated [in] Whether to disregard this LSA if it was
      *                                self-originated.
-     * @param fromRoutingTable   [in] The Routing Table from which to select the
-     *                                preferred RoutingTableEntry. If it is nullptr
+     * @param fromRoutingTable   [in] The index of the Routing Table from which to select
+     *                                the preferred RoutingTableEntry. If it is nullptr
      *                                then the router's current routing table is
      *                                used instead.
      * @return The preferred RoutingTableEntry, or nullptr if no such entry exists.
      * @sa RFC2328 Section 16.4. points(1) through(3)
      * @sa Area::originateSummaryLSA
      */
-    Ospfv2RoutingTableEntry *getPreferredEntry(const Ospfv2Lsa& lsa, bool skipSelfOriginated, std::vector<Ospfv2RoutingTableEntry *> *fromRoutingTable = nullptr);
+    Ospfv2RoutingTableEntry *getPreferredEntry(const Ospfv2Lsa& lsa, bool skipSelfOriginated, const Ospfv2RoutingTableIndex *fromRoutingTable = nullptr);
 
     /*
      * @sqsq
      */
     IInterfaceTable *getIft() { return ift; }
 
+    cSimpleModule *getOspfModule() { return ospfModule; }
+
+    /**
+     * Returns the number of LSAs in the databases of all areas and in the AS-external database.
+     */
+    unsigned long getLsdbSize() const;
+
   private:
     /**
      * Installs a new AS External LSA into the Router's database.
@@ -329,6 +402,28 @@ class INET_API Router
      */
     void calculateASExternalRoutes(std::vector<Ospfv2RoutingTableEntry *>& newRoutingTable);
 
+    /**
+     * Calculates the complete routing table from the LSA databases. Only
+     * reads the databases of this router and writes the SPF state of its
+     * LSAs, so it may run outside of the simulation thread.
+     * @param newRoutingTable [out] Receives the new RoutingTableEntries.
+     */
+    void calculateRoutingTable(std::vector<Ospfv2RoutingTableEntry *>& newRoutingTable);
+
+    /**
+     * Replaces the routing table with the calculated one and applies the
+     * difference to the Ipv4 routing table.
+     * @param newRoutingTable     [in] The result of calculateRoutingTable().
+     * @param calculationDuration [in] Wall-clock duration of calculateRoutingTable() in seconds.
+     */
+    void installRoutingTable(std::vector<Ospfv2RoutingTableEntry *>& newRoutingTable, double calculationDuration);
+
+    /**
+     * Waits for the routing table calculation running in the background and
+     * throws its result away.
+     */
+    void cancelRoutingTableRebuild();
+
     /**
      * After a routing table rebuild the changes in the routing table are
      * identified and new SummaryLSAs are originated or old ones are flooded out
@@ -342,19 +437,19 @@ class INET_API Router
     /**
      * Returns true if there is a route to the AS Boundary Router identified by
      * asbrRouterID in the input inRoutingTable, false otherwise.
-     * @param inRoutingTable [in] The routing table to look in.
+     * @param inRoutingTable [in] The index of the routing table to look in.
      * @param asbrRouterID   [in] The ID of the AS Boundary Router to look for.
      */
-    bool hasRouteToASBoundaryRouter(const std::vector<Ospfv2RoutingTableEntry *>& inRoutingTable, RouterId routerID) const;
+    bool hasRouteToASBoundaryRouter(const Ospfv2RoutingTableIndex& inRoutingTable, RouterId routerID) const;
 
     /**
      * Returns an std::vector of routes leading to the AS Boundary Router
      * identified by asbrRouterID from the input fromRoutingTable. If there are no
      * routes leading to the AS Boundary Router, the returned std::vector is empty.
-     * @param fromRoutingTable [in] The routing table to look in.
+     * @param fromRoutingTable [in] The index of the routing table to look in.
      * @param asbrRouterID     [in] The ID of the AS Boundary Router to look for.
      */
-    std::vector<Ospfv2RoutingTableEntry *> getRoutesToASBoundaryRouter(const std::vector<Ospfv2RoutingTableEntry *>& fromRoutingTable, RouterId routerID) const;
+    std::vector<Ospfv2RoutingTableEntry *> getRoutesToASBoundaryRouter(const Ospfv2RoutingTableIndex& fromRoutingTable, RouterId routerID) const;
 
     /**
      * Prunes the input std::vector of RoutingTableEntries according to the RFC2328
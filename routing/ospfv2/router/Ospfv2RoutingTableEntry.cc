@@ -40,6 +40,26 @@ Ospfv2RoutingTableEntry::Ospfv2RoutingTableEntry(const Ospfv2RoutingTableEntry&
     setAdminDist(entry.getAdminDist());
 }
 
+void Ospfv2RoutingTableEntry::reset()
+{
+    destinationType = Ospfv2RoutingTableEntry::NETWORK_DESTINATION;
+    optionalCapabilities = Ospfv2Options();
+    area = BACKBONE_AREAID;
+    pathType = Ospfv2RoutingTableEntry::INTRAAREA;
+    cost = 0;
+    type2Cost = 0;
+    linkStateOrigin = nullptr;
+    nextHops.clear();
+
+    setDestination(Ipv4Address::UNSPECIFIED_ADDRESS);
+    setNetmask(Ipv4Address::ALLONES_ADDRESS);
+    setGateway(Ipv4Address::UNSPECIFIED_ADDRESS);
+    setInterface(nullptr);
+    setMetric(0);
+    setSourceType(IRoute::OSPF);
+    setAdminDist(Ipv4Route::dOSPF);
+}
+
 void Ospfv2RoutingTableEntry::addNextHop(NextHop hop)
 {
     if (nextHops.size() == 0) {
@@ -45,7 +45,7 @@ class INET_API Ospfv2RoutingTableEntry : public Ipv4Route
     Metric cost = 0;
     Metric type2Cost = 0;
     const Ospfv2Lsa *linkStateOrigin = nullptr;
-    std::vector<NextHop> nextHops;
+    NextHopVector nextHops;
     // Ipv4Route::interfacePtr comes from nextHops[0].ifIndex
     // Ipv4Route::gateway is nextHops[0].hopAddress
 
@@ -54,6 +54,12 @@ class INET_API Ospfv2RoutingTableEntry : public Ipv4Route
     Ospfv2RoutingTableEntry(const Ospfv2RoutingTableEntry& entry);
     virtual ~Ospfv2RoutingTableEntry() {}
 
+    /**
+     * Restores the state set by the constructor, so that the object can be
+     * reused by Ospfv2RoutingTableEntryPool.
+     */
+    void reset();
+
     bool operator==(const Ospfv2RoutingTableEntry& entry) const;
     bool operator!=(const Ospfv2RoutingTableEntry& entry) const { return !((*this) == entry); }
 
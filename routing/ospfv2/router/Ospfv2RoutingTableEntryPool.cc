@@ -0,0 +1,45 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#include "inet/routing/ospfv2/router/Ospfv2RoutingTableEntryPool.h"
+
+namespace inet {
+namespace ospfv2 {
+
+Ospfv2RoutingTableEntryPool::~Ospfv2RoutingTableEntryPool()
+{
+    for (auto entry : freeEntries)
+        delete entry;
+}
+
+Ospfv2RoutingTableEntry *Ospfv2RoutingTableEntryPool::acquire()
+{
+    if (freeEntries.empty())
+        return new Ospfv2RoutingTableEntry(ift);
+
+    Ospfv2RoutingTableEntry *entry = freeEntries.back();
+    freeEntries.pop_back();
+    entry->reset();
+    return entry;
+}
+
+void Ospfv2RoutingTableEntryPool::release(Ospfv2RoutingTableEntry *entry)
+{
+    if (entry == nullptr)
+        return;
+    ASSERT(entry->getRoutingTable() == nullptr);
+    freeEntries.push_back(entry);
+}
+
+void Ospfv2RoutingTableEntryPool::releaseAll(std::vector<Ospfv2RoutingTableEntry *>& entries)
+{
+    freeEntries.reserve(freeEntries.size() + entries.size());
+    for (auto entry : entries)
+        release(entry);
+    entries.clear();
+}
+
+} // namespace ospfv2
+} // namespace inet
+
@@ -0,0 +1,83 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#include "inet/routing/ospfv2/router/Ospfv2RoutingTableIndex.h"
+
+#include <algorithm>
+
+#include "inet/common/stlutils.h"
+
+namespace inet {
+namespace ospfv2 {
+
+void Ospfv2RoutingTableIndex::rebuild()
+{
+    entriesByNetwork.clear();
+    netmaskCounts.clear();
+    nextSequenceNumber = 0;
+    for (auto entry : table)
+        insert(entry);
+}
+
+void Ospfv2RoutingTableIndex::insert(Ospfv2RoutingTableEntry *entry)
+{
+    uint32_t netmask = entry->getNetmask().getInt();
+    uint32_t network = entry->getDestination().getInt() & netmask;
+    entriesByNetwork[getKey(netmask, network)].push_back({nextSequenceNumber++, entry});
+    netmaskCounts[netmask]++;
+}
+
+void Ospfv2RoutingTableIndex::erase(Ospfv2RoutingTableEntry *entry)
+{
+    uint32_t netmask = entry->getNetmask().getInt();
+    uint32_t network = entry->getDestination().getInt() & netmask;
+    auto it = entriesByNetwork.find(getKey(netmask, network));
+    if (it == entriesByNetwork.end())
+        throw cRuntimeError("Routing table entry is not indexed, its destination was changed while in the table");
+    auto& bucket = it->second;
+    auto position = std::find_if(bucket.begin(), bucket.end(), [&] (const IndexedEntry& indexedEntry) { return indexedEntry.entry == entry; });
+    if (position == bucket.end())
+        throw cRuntimeError("Routing table entry is not indexed, its destination was changed while in the table");
+    bucket.erase(position);
+    if (bucket.empty())
+        entriesByNetwork.erase(it);
+    if (--netmaskCounts[netmask] == 0)
+        netmaskCounts.erase(netmask);
+}
+
+void Ospfv2RoutingTableIndex::addEntry(Ospfv2RoutingTableEntry *entry)
+{
+    table.push_back(entry);
+    insert(entry);
+}
+
+bool Ospfv2RoutingTableIndex::removeEntry(Ospfv2RoutingTableEntry *entry)
+{
+    auto it = find(table, entry);
+    if (it == table.end())
+        return false;
+    table.erase(it);
+    erase(entry);
+    return true;
+}
+
+void Ospfv2RoutingTableIndex::findMatchingEntries(Ipv4Address address, std::vector<Ospfv2RoutingTableEntry *>& entries) const
+{
+    std::vector<IndexedEntry> matchingEntries;
+    for (auto& elem : netmaskCounts) {
+        uint32_t netmask = elem.first;
+        auto it = entriesByNetwork.find(getKey(netmask, address.getInt() & netmask));
+        if (it != entriesByNetwork.end())
+            matchingEntries.insert(matchingEntries.end(), it->second.begin(), it->second.end());
+    }
+    // the buckets are in table order, but the netmasks are not
+    std::sort(matchingEntries.begin(), matchingEntries.end(), [] (const IndexedEntry& a, const IndexedEntry& b) { return a.sequenceNumber < b.sequenceNumber; });
+    entries.clear();
+    for (auto& indexedEntry : matchingEntries)
+        entries.push_back(indexedEntry.entry);
+}
+
+} // namespace ospfv2
+} // namespace inet
+
@@ -0,0 +1,84 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#ifndef __INET_OSPFV2ROUTINGTABLEINDEX_H
+#define __INET_OSPFV2ROUTINGTABLEINDEX_H
+
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "inet/routing/ospfv2/router/Ospfv2RoutingTableEntry.h"
+
+namespace inet {
+
+namespace ospfv2 {
+
+/**
+ * Destination index of an OSPF routing table. The table itself stays an
+ * std::vector, so the iteration order is unchanged; the index hashes its
+ * entries by network address and netmask, and answers which entries cover
+ * a given address by probing one bucket per netmask present in the table.
+ * The result is returned in table order, so the lookups that pick the first
+ * matching entry behave exactly as the linear scans they replace.
+ *
+ * Entries must be added and removed through the index while it is in use,
+ * and their destination and netmask must not change while they are indexed.
+ * After modifying the table directly, call rebuild().
+ */
+class INET_API Ospfv2RoutingTableIndex
+{
+  public:
+    typedef std::vector<Ospfv2RoutingTableEntry *> RoutingTable;
+
+  private:
+    struct IndexedEntry {
+        uint64_t sequenceNumber; // position in the table, only the order matters
+        Ospfv2RoutingTableEntry *entry;
+    };
+
+    RoutingTable& table;
+    std::unordered_map<uint64_t, std::vector<IndexedEntry>> entriesByNetwork; // netmask and network address -> entries in table order
+    std::map<uint32_t, int, std::greater<uint32_t>> netmaskCounts; // netmasks present in the table, longest first
+    uint64_t nextSequenceNumber = 0;
+
+  private:
+    static uint64_t getKey(uint32_t netmask, uint32_t network) { return ((uint64_t)netmask << 32) | network; }
+    void insert(Ospfv2RoutingTableEntry *entry);
+    void erase(Ospfv2RoutingTableEntry *entry);
+
+  public:
+    explicit Ospfv2RoutingTableIndex(RoutingTable& table) : table(table) { rebuild(); }
+
+    RoutingTable& getTable() const { return table; }
+
+    /**
+     * Indexes the table again from scratch.
+     */
+    void rebuild();
+
+    /**
+     * Appends the entry to the table.
+     */
+    void addEntry(Ospfv2RoutingTableEntry *entry);
+
+    /**
+     * Removes the entry from the table. Returns false if it was not in the table.
+     */
+    bool removeEntry(Ospfv2RoutingTableEntry *entry);
+
+    /**
+     * Collects the entries whose destination network contains the address,
+     * i.e. (destination & netmask) == (address & netmask), in table order.
+     */
+    void findMatchingEntries(Ipv4Address address, std::vector<Ospfv2RoutingTableEntry *>& entries) const;
+};
+
+} // namespace ospfv2
+
+} // namespace inet
+
+#endif
+
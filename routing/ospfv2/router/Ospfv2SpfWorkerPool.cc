@@ -0,0 +1,91 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#include "inet/routing/ospfv2/router/Ospfv2SpfWorkerPool.h"
+
+#include <memory>
+
+#include "inet/common/SimulationScopedSingleton.h"
+
+namespace inet {
+
+namespace ospfv2 {
+
+namespace {
+
+/**
+ * Owns the pool of the current network; the threads are stopped when the
+ * network is deleted, i.e. after all routers have waited for their jobs.
+ */
+class Ospfv2SpfWorkerPoolHolder : public SimulationScopedSingleton<Ospfv2SpfWorkerPoolHolder>
+{
+  protected:
+    virtual void clear() override { pool.reset(); }
+
+  public:
+    std::unique_ptr<Ospfv2SpfWorkerPool> pool;
+};
+
+} // namespace
+
+Ospfv2SpfWorkerPool::Ospfv2SpfWorkerPool(int numThreads)
+{
+    if (numThreads <= 0)
+        throw cRuntimeError("Invalid number of SPF worker threads: %d", numThreads);
+    for (int i = 0; i < numThreads; i++)
+        threads.push_back(std::thread(&Ospfv2SpfWorkerPool::run, this));
+}
+
+Ospfv2SpfWorkerPool::~Ospfv2SpfWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    jobAvailable.notify_all();
+    for (auto& thread : threads)
+        thread.join();
+}
+
+void Ospfv2SpfWorkerPool::run()
+{
+    while (true) {
+        std::packaged_task<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobAvailable.wait(lock, [this] () { return stopping || !jobs.empty(); });
+            if (jobs.empty())
+                return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        job();
+    }
+}
+
+std::future<void> Ospfv2SpfWorkerPool::submit(std::function<void()> job)
+{
+    std::packaged_task<void()> task(std::move(job));
+    std::future<void> future = task.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(task));
+    }
+    jobAvailable.notify_one();
+    return future;
+}
+
+Ospfv2SpfWorkerPool *Ospfv2SpfWorkerPool::getInstance(int numThreads)
+{
+    auto& poolHolder = Ospfv2SpfWorkerPoolHolder::getInstance();
+    if (poolHolder.pool == nullptr)
+        poolHolder.pool.reset(new Ospfv2SpfWorkerPool(numThreads));
+    else if (poolHolder.pool->getNumThreads() != numThreads)
+        throw cRuntimeError("All Ospfv2 modules of the network must use the same spfThreads value");
+    return poolHolder.pool.get();
+}
+
+} // namespace ospfv2
+
+} // namespace inet
@@ -0,0 +1,67 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+#ifndef __INET_OSPFV2SPFWORKERPOOL_H
+#define __INET_OSPFV2SPFWORKERPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "inet/common/INETDefs.h"
+
+namespace inet {
+
+namespace ospfv2 {
+
+/**
+ * A fixed set of threads that run routing table calculations in the
+ * background. One pool is shared by all routers of the network; it is
+ * destroyed together with the network.
+ *
+ * The jobs must only touch the data of a single router, and the simulation
+ * thread must not touch that router until the job's future is ready (see
+ * Router::requestRoutingTableRebuild()). The results are always committed on
+ * the simulation thread, so the order in which the jobs finish does not
+ * influence the simulation.
+ */
+class INET_API Ospfv2SpfWorkerPool
+{
+  private:
+    std::vector<std::thread> threads;
+    std::deque<std::packaged_task<void()>> jobs;
+    std::mutex mutex;
+    std::condition_variable jobAvailable;
+    bool stopping = false;
+
+  private:
+    void run();
+
+  public:
+    explicit Ospfv2SpfWorkerPool(int numThreads);
+    ~Ospfv2SpfWorkerPool();
+
+    int getNumThreads() const { return threads.size(); }
+
+    /**
+     * Queues the job; exceptions thrown by it are rethrown by the get() of
+     * the returned future.
+     */
+    std::future<void> submit(std::function<void()> job);
+
+    /**
+     * Returns the pool of the current network, creating it on the first call.
+     */
+    static Ospfv2SpfWorkerPool *getInstance(int numThreads);
+};
+
+} // namespace ospfv2
+
+} // namespace inet
+
+#endif
@@ -31,6 +31,8 @@
 #include "inet/transportlayer/tcp/Tcp.h"
 #include "inet/transportlayer/tcp/TcpConnection.h"
 #include "inet/transportlayer/tcp/TcpReceiveQueue.h"
+#include "inet/transportlayer/tcp/TcpRopeReceiveQueue.h"
+#include "inet/transportlayer/tcp/TcpRopeSendQueue.h"
 #include "inet/transportlayer/tcp/TcpSendQueue.h"
 #include "inet/transportlayer/tcp_common/TcpHeader.h"
 
@@ -58,6 +60,7 @@ void Tcp::initialize(int stage)
 
         msl = par("msl");
         useDataNotification = par("useDataNotification");
+        ropeQueues = par("ropeQueues");
 
         WATCH(lastEphemeralPort);
         WATCH_PTRMAP(tcpConnMap);
@@ -207,6 +210,7 @@ void Tcp::removeConnection(TcpConnection *conn)
     key2.localPort = conn->localPort;
     key2.remotePort = conn->remotePort;
     tcpConnMap.erase(key2);
+    tcpConnIndex.erase(key2);
 
     // IMPORTANT: usedEphemeralPorts.erase(conn->localPort) is NOT GOOD because it
     // deletes ALL occurrences of the port from the multiset.
@@ -229,31 +233,31 @@ TcpConnection *Tcp::findConnForSegment(const Ptr<const TcpHeader>& tcpHeader, L3
     SockPair save = key;
 
     // try with fully qualified SockPair
-    auto i = tcpConnMap.find(key);
-    if (i != tcpConnMap.end())
+    auto i = tcpConnIndex.find(key);
+    if (i != tcpConnIndex.end())
         return i->second;
 
     // try with localAddr missing (only localPort specified in passive/active open)
     key.localAddr = L3Address();
-    i = tcpConnMap.find(key);
+    i = tcpConnIndex.find(key);
 
-    if (i != tcpConnMap.end())
+    if (i != tcpConnIndex.end())
         return i->second;
 
     // try fully qualified local socket + blank remote socket (for incoming SYN)
     key = save;
     key.remoteAddr = L3Address();
     key.remotePort = -1;
-    i = tcpConnMap.find(key);
+    i = tcpConnIndex.find(key);
 
-    if (i != tcpConnMap.end())
+    if (i != tcpConnIndex.end())
         return i->second;
 
     // try with blank remote socket, and localAddr missing (for incoming SYN)
     key.localAddr = L3Address();
-    i = tcpConnMap.find(key);
+    i = tcpConnIndex.find(key);
 
-    if (i != tcpConnMap.end())
+    if (i != tcpConnIndex.end())
         return i->second;
 
     // given up
@@ -311,8 +315,8 @@ void Tcp::addSockPair(TcpConnection *conn, L3Address localAddr, L3Address remote
     key.remotePort = conn->remotePort = remotePort;
 
     // make sure connection is unique
-    auto it = tcpConnMap.find(key);
-    if (it != tcpConnMap.end()) {
+    auto it = tcpConnIndex.find(key);
+    if (it != tcpConnIndex.end()) {
         // throw "address already in use" error
         if (remoteAddr.isUnspecified() && remotePort == -1)
             throw cRuntimeError("Address already in use: there is already a connection listening on %s:%d",
@@ -324,6 +328,7 @@ void Tcp::addSockPair(TcpConnection *conn, L3Address localAddr, L3Address remote
 
     // then insert it into tcpConnMap
     tcpConnMap[key] = conn;
+    tcpConnIndex[key] = conn;
 
     // mark port as used
     if (localPort >= EPHEMERAL_PORTRANGE_START && localPort < EPHEMERAL_PORTRANGE_END)
@@ -344,6 +349,7 @@ void Tcp::updateSockPair(TcpConnection *conn, L3Address localAddr, L3Address rem
 
     // ...and remove from the old place in tcpConnMap
     tcpConnMap.erase(it);
+    tcpConnIndex.erase(key);
 
     // then update addresses/ports, and re-insert it with new key into tcpConnMap
     key.localAddr = conn->localAddr = localAddr;
@@ -351,17 +357,22 @@ void Tcp::updateSockPair(TcpConnection *conn, L3Address localAddr, L3Address rem
     ASSERT(conn->localPort == localPort);
     key.remotePort = conn->remotePort = remotePort;
     tcpConnMap[key] = conn;
+    tcpConnIndex[key] = conn;
 
     // localPort doesn't change (see ASSERT above), so there's no need to update usedEphemeralPorts[].
 }
 
 TcpSendQueue *Tcp::createSendQueue()
 {
+    if (ropeQueues)
+        return new TcpRopeSendQueue();
     return new TcpSendQueue();
 }
 
 TcpReceiveQueue *Tcp::createReceiveQueue()
 {
+    if (ropeQueues)
+        return new TcpRopeReceiveQueue();
     return new TcpReceiveQueue();
 }
 
@@ -389,6 +400,7 @@ void Tcp::reset()
         elem.second->deleteModule();
     tcpAppConnMap.clear();
     tcpConnMap.clear();
+    tcpConnIndex.clear();
     usedEphemeralPorts.clear();
     lastEphemeralPort = EPHEMERAL_PORTRANGE_START;
 }
@@ -10,6 +10,7 @@
 
 #include <map>
 #include <set>
+#include <unordered_map>
 
 #include "inet/common/lifecycle/ModuleOperations.h"
 #include "inet/common/packet/Packet.h"
@@ -109,13 +110,26 @@ class INET_API Tcp : public TransportProtocolBase
             else
                 return localPort < b.localPort;
         }
+
+        inline bool operator==(const SockPair& b) const
+        {
+            return localPort == b.localPort && remotePort == b.remotePort && remoteAddr == b.remoteAddr && localAddr == b.localAddr;
+        }
+    };
+
+    struct SockPairHash {
+        size_t operator()(const SockPair& key) const {
+            return key.remoteAddr.getHash() * 31 + key.localAddr.getHash() + ((size_t)(key.localPort & 0xFFFF) << 16 | (key.remotePort & 0xFFFF));
+        }
     };
 
   protected:
     typedef std::map<int /*socketId*/, TcpConnection *> TcpAppConnMap;
     typedef std::map<SockPair, TcpConnection *> TcpConnMap;
+    typedef std::unordered_map<SockPair, TcpConnection *, SockPairHash> TcpConnIndex;
     TcpAppConnMap tcpAppConnMap;
     TcpConnMap tcpConnMap;
+    TcpConnIndex tcpConnIndex; // same content as tcpConnMap, used for the per segment lookups
 
     ushort lastEphemeralPort = static_cast<ushort>(-1);
     std::multiset<ushort> usedEphemeralPorts;
@@ -132,6 +146,7 @@ class INET_API Tcp : public TransportProtocolBase
 
   public:
     bool useDataNotification = false;
+    bool ropeQueues = false;
     CrcMode crcMode = CRC_MODE_UNDEFINED;
     int msl;
 
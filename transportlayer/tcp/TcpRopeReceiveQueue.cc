@@ -0,0 +1,177 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+
+#include "inet/transportlayer/tcp/TcpRopeReceiveQueue.h"
+
+namespace inet {
+namespace tcp {
+
+Register_Class(TcpRopeReceiveQueue);
+
+void TcpRopeReceiveQueue::init(uint32_t startSeq)
+{
+    TcpReceiveQueue::init(startSeq);
+    pieces.clear();
+    regions.clear();
+    expectedPosition = startSeq;
+    bufferedBytes = 0;
+}
+
+std::string TcpRopeReceiveQueue::str() const
+{
+    std::ostringstream buf;
+    buf << "rcv_nxt=" << rcv_nxt;
+    for (auto& region : regions)
+        buf << " [" << positionToSeq(region.first) << ".." << positionToSeq(region.second) << ")";
+    return buf.str();
+}
+
+void TcpRopeReceiveQueue::insertPiece(uint64_t position, const Ptr<const Chunk>& data)
+{
+    uint64_t endPosition = position + B(data->getChunkLength()).get();
+    auto it = pieces.lower_bound(position);
+    // cut the end of the previous piece, it may also continue after the new one
+    if (it != pieces.begin()) {
+        auto previous = std::prev(it);
+        uint64_t previousPosition = previous->first;
+        uint64_t previousEndPosition = getEndPosition(*previous);
+        if (previousEndPosition > position) {
+            auto previousData = previous->second;
+            previous->second = previousData->peek(Chunk::Iterator(B(0)), B(position - previousPosition));
+            if (previousEndPosition > endPosition)
+                pieces.emplace(endPosition, previousData->peek(Chunk::Iterator(B(endPosition - previousPosition)), B(previousEndPosition - endPosition)));
+        }
+    }
+    // remove the covered pieces and cut the beginning of the last overlapping one
+    while (it != pieces.end() && it->first < endPosition) {
+        uint64_t pieceEndPosition = getEndPosition(*it);
+        if (pieceEndPosition <= endPosition)
+            it = pieces.erase(it);
+        else {
+            auto tail = it->second->peek(Chunk::Iterator(B(endPosition - it->first)), B(pieceEndPosition - endPosition));
+            pieces.erase(it);
+            pieces.emplace(endPosition, tail);
+            break;
+        }
+    }
+    pieces.emplace(position, data);
+}
+
+void TcpRopeReceiveQueue::insertRegion(uint64_t startPosition, uint64_t endPosition)
+{
+    // merge with all overlapping and adjacent regions
+    auto it = regions.upper_bound(startPosition);
+    if (it != regions.begin() && std::prev(it)->second >= startPosition)
+        it--;
+    while (it != regions.end() && it->first <= endPosition) {
+        startPosition = std::min(startPosition, it->first);
+        endPosition = std::max(endPosition, it->second);
+        bufferedBytes -= it->second - it->first;
+        it = regions.erase(it);
+    }
+    regions.emplace(startPosition, endPosition);
+    bufferedBytes += endPosition - startPosition;
+}
+
+uint32_t TcpRopeReceiveQueue::insertBytesFromSegment(Packet *tcpSegment, const Ptr<const TcpHeader>& tcpHeader)
+{
+    B tcpHeaderLength = tcpHeader->getHeaderLength();
+    B tcpPayloadLength = tcpSegment->getDataLength() - tcpHeaderLength;
+    uint32_t seq = tcpHeader->getSequenceNo();
+    uint32_t offs = 0;
+    uint32_t buffSeq = positionToSeq(expectedPosition);
+
+    if (seqLess(seq, buffSeq)) {
+        offs = buffSeq - seq;
+        seq = buffSeq;
+        tcpPayloadLength -= B(offs);
+    }
+    if (tcpPayloadLength > B(0)) {
+        const auto& payload = tcpSegment->peekDataAt(tcpHeaderLength + B(offs), tcpPayloadLength);
+        uint64_t position = seqToPosition(seq);
+        insertPiece(position, payload);
+        insertRegion(position, position + tcpPayloadLength.get());
+    }
+
+    if (!regions.empty() && seqGE(rcv_nxt, positionToSeq(regions.begin()->first)))
+        rcv_nxt = positionToSeq(regions.begin()->second);
+
+    return rcv_nxt;
+}
+
+Packet *TcpRopeReceiveQueue::extractBytesUpTo(uint32_t seq)
+{
+    ASSERT(seqLE(seq, rcv_nxt));
+
+    if (regions.empty())
+        return nullptr;
+
+    uint64_t position = seqToPosition(seq);
+    auto region = regions.begin();
+    if (region->first != expectedPosition || position <= expectedPosition)
+        return nullptr;
+    uint64_t endPosition = std::min(position, region->second);
+
+    // the pieces are concatenated only here
+    Packet *msg = new Packet("data");
+    auto it = pieces.begin();
+    while (it != pieces.end() && it->first < endPosition) {
+        uint64_t pieceEndPosition = getEndPosition(*it);
+        if (pieceEndPosition <= endPosition) {
+            msg->insertAtBack(it->second);
+            it = pieces.erase(it);
+        }
+        else {
+            uint64_t length = endPosition - it->first;
+            msg->insertAtBack(it->second->peek(Chunk::Iterator(B(0)), B(length)));
+            auto tail = it->second->peek(Chunk::Iterator(B(length)), B(pieceEndPosition - endPosition));
+            pieces.erase(it);
+            pieces.emplace(endPosition, tail);
+            break;
+        }
+    }
+
+    uint64_t regionEndPosition = region->second;
+    regions.erase(region);
+    if (regionEndPosition > endPosition)
+        regions.emplace(endPosition, regionEndPosition);
+    bufferedBytes -= endPosition - expectedPosition;
+    expectedPosition = endPosition;
+    return msg;
+}
+
+void TcpRopeReceiveQueue::getQueueStatus()
+{
+    EV_DEBUG << "receiveQLength=" << regions.size() << " " << str() << "\n";
+}
+
+uint32_t TcpRopeReceiveQueue::getLE(uint32_t fromSeqNum)
+{
+    uint64_t position = seqToPosition(fromSeqNum);
+    auto it = regions.upper_bound(position);
+    if (it != regions.begin() && position < std::prev(it)->second)
+        return positionToSeq(std::prev(it)->first);
+    return fromSeqNum;
+}
+
+uint32_t TcpRopeReceiveQueue::getRE(uint32_t toSeqNum)
+{
+    uint64_t position = seqToPosition(toSeqNum);
+    auto it = regions.lower_bound(position);
+    if (it != regions.begin() && position <= std::prev(it)->second)
+        return positionToSeq(std::prev(it)->second);
+    return toSeqNum;
+}
+
+uint32_t TcpRopeReceiveQueue::getFirstSeqNo()
+{
+    if (regions.empty())
+        return rcv_nxt;
+    return seqMin(positionToSeq(regions.begin()->first), rcv_nxt);
+}
+
+} // namespace tcp
+} // namespace inet
+
@@ -0,0 +1,75 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+
+#ifndef __INET_TCPROPERECEIVEQUEUE_H
+#define __INET_TCPROPERECEIVEQUEUE_H
+
+#include <map>
+
+#include "inet/transportlayer/tcp/TcpReceiveQueue.h"
+
+namespace inet {
+namespace tcp {
+
+/**
+ * Receive queue that keeps the payload chunks of the received segments as
+ * they arrived, without merging consecutive chunks into one chunk. The chunks
+ * are stored in a map keyed by their position in the byte stream, and a
+ * separate map keeps the contiguous regions for rcv_nxt and SACK. Newer data
+ * replaces overlapping older data, just like in ReorderBuffer. The chunks are
+ * only concatenated when a packet is created for the application. The
+ * reorderBuffer of TcpReceiveQueue is not used.
+ *
+ * Select it with the ropeQueues parameter of Tcp.
+ */
+class INET_API TcpRopeReceiveQueue : public TcpReceiveQueue
+{
+  protected:
+    std::map<uint64_t, Ptr<const Chunk>> pieces; // start position -> data, non-overlapping
+    std::map<uint64_t, uint64_t> regions; // start position -> end position, maximal contiguous ranges of pieces
+    uint64_t expectedPosition = 0; // position of the next byte passed up to the app
+    uint32_t bufferedBytes = 0;
+
+  protected:
+    uint32_t positionToSeq(uint64_t position) const { return (uint32_t)position; }
+
+    uint64_t seqToPosition(uint32_t seq) const
+    {
+        uint32_t expectedSeq = positionToSeq(expectedPosition);
+        return seqGE(seq, expectedSeq) ? expectedPosition + (seq - expectedSeq) : expectedPosition - (expectedSeq - seq);
+    }
+
+    static uint64_t getEndPosition(const std::pair<const uint64_t, Ptr<const Chunk>>& piece) { return piece.first + B(piece.second->getChunkLength()).get(); }
+
+    virtual void insertPiece(uint64_t position, const Ptr<const Chunk>& data);
+    virtual void insertRegion(uint64_t startPosition, uint64_t endPosition);
+
+  public:
+    virtual void init(uint32_t startSeq) override;
+
+    virtual std::string str() const override;
+
+    virtual uint32_t insertBytesFromSegment(Packet *tcpSegment, const Ptr<const TcpHeader>& tcpHeader) override;
+
+    virtual Packet *extractBytesUpTo(uint32_t seq) override;
+
+    virtual uint32_t getAmountOfBufferedBytes() override { return bufferedBytes; }
+
+    virtual uint32_t getQueueLength() override { return regions.size(); }
+
+    virtual void getQueueStatus() override;
+
+    virtual uint32_t getLE(uint32_t fromSeqNum) override;
+
+    virtual uint32_t getRE(uint32_t toSeqNum) override;
+
+    virtual uint32_t getFirstSeqNo() override;
+};
+
+} // namespace tcp
+} // namespace inet
+
+#endif
+
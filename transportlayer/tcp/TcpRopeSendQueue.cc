@@ -0,0 +1,82 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+
+#include "inet/transportlayer/tcp/TcpRopeSendQueue.h"
+
+#include <algorithm>
+
+namespace inet {
+namespace tcp {
+
+Register_Class(TcpRopeSendQueue);
+
+void TcpRopeSendQueue::init(uint32_t startSeq)
+{
+    TcpSendQueue::init(startSeq);
+    pieces.clear();
+    beginPosition = 0;
+    endPosition = 0;
+}
+
+std::string TcpRopeSendQueue::str() const
+{
+    std::stringstream out;
+    out << "[" << begin << ".." << end << "), " << pieces.size() << " chunks";
+    return out.str();
+}
+
+void TcpRopeSendQueue::enqueueAppData(Packet *msg)
+{
+    uint32_t length = msg->getByteLength();
+    if (length != 0) {
+        pieces.push_back({endPosition, msg->peekDataAt(B(0), msg->getDataLength())});
+        endPosition += length;
+    }
+    end += length;
+    if (seqLess(end, begin))
+        throw cRuntimeError("Send queue is full");
+    delete msg;
+}
+
+Packet *TcpRopeSendQueue::createSegmentWithBytes(uint32_t fromSeq, uint32_t numBytes)
+{
+    ASSERT(seqLE(begin, fromSeq) && seqLE(fromSeq + numBytes, end));
+
+    char msgname[32];
+    sprintf(msgname, "tcpseg(l=%u)", (unsigned int)numBytes);
+
+    Packet *tcpSegment = new Packet(msgname);
+    uint64_t position = beginPosition + (fromSeq - begin);
+    uint64_t segmentEndPosition = position + numBytes;
+    // the last piece that starts at or before position
+    auto it = std::upper_bound(pieces.begin(), pieces.end(), position, [] (uint64_t position, const Piece& piece) { return position < piece.position; });
+    if (numBytes != 0)
+        it--;
+    for (; position < segmentEndPosition; it++) {
+        uint64_t offset = position - it->position;
+        uint64_t length = std::min(it->getEndPosition(), segmentEndPosition) - position;
+        if (offset == 0 && position + length == it->getEndPosition())
+            tcpSegment->insertAtBack(it->data);
+        else
+            tcpSegment->insertAtBack(it->data->peek(Chunk::Iterator(B(offset)), B(length)));
+        position += length;
+    }
+    return tcpSegment;
+}
+
+void TcpRopeSendQueue::discardUpTo(uint32_t seqNum)
+{
+    ASSERT(seqLE(begin, seqNum) && seqLE(seqNum, end));
+
+    beginPosition += seqNum - begin;
+    begin = seqNum;
+    // a partially acknowledged piece is kept as it is
+    while (!pieces.empty() && pieces.front().getEndPosition() <= beginPosition)
+        pieces.pop_front();
+}
+
+} // namespace tcp
+} // namespace inet
+
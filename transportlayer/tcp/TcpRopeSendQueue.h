@@ -0,0 +1,56 @@
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+//
+
+
+#ifndef __INET_TCPROPESENDQUEUE_H
+#define __INET_TCPROPESENDQUEUE_H
+
+#include <deque>
+
+#include "inet/transportlayer/tcp/TcpSendQueue.h"
+
+namespace inet {
+namespace tcp {
+
+/**
+ * Send queue that keeps the chunks of the application data as they were
+ * enqueued, without merging them into one chunk. Every chunk is stored
+ * together with its position in the byte stream, so the chunks of a segment
+ * are found by binary search, and only the first and the last chunk of the
+ * segment are sliced. Acknowledged chunks are dropped from the front. The
+ * dataBuffer of TcpSendQueue is not used.
+ *
+ * Select it with the ropeQueues parameter of Tcp.
+ */
+class INET_API TcpRopeSendQueue : public TcpSendQueue
+{
+  protected:
+    struct Piece {
+        uint64_t position; // position of the first byte in the stream
+        Ptr<const Chunk> data;
+
+        uint64_t getEndPosition() const { return position + B(data->getChunkLength()).get(); }
+    };
+
+    std::deque<Piece> pieces;
+    uint64_t beginPosition = 0; // position of the byte with sequence number begin
+    uint64_t endPosition = 0; // position of the byte with sequence number end
+
+  public:
+    virtual void init(uint32_t startSeq) override;
+
+    virtual std::string str() const override;
+
+    virtual void enqueueAppData(Packet *msg) override;
+
+    virtual Packet *createSegmentWithBytes(uint32_t fromSeq, uint32_t numBytes) override;
+
+    virtual void discardUpTo(uint32_t seqNum) override;
+};
+
+} // namespace tcp
+} // namespace inet
+
+#endif
+
@@ -99,6 +99,8 @@ void TcpBaseAlg::initialize()
     persistTimer->setContextPointer(conn);
     delayedAckTimer->setContextPointer(conn);
     keepAliveTimer->setContextPointer(conn);
+
+    lazyRexmitTimer = conn->getTcpMain()->par("lazyRexmitTimer");
 }
 
 void TcpBaseAlg::established(bool active)
@@ -166,6 +168,12 @@ void TcpBaseAlg::connectionClosed()
 
 void TcpBaseAlg::processTimer(cMessage *timer, TcpEventCode& event)
 {
+    if (timer == rexmitTimer && simTime() < rexmitDeadline) {
+        // the timer was restarted lazily, move it to the actual deadline
+        conn->scheduleAt(rexmitDeadline, rexmitTimer);
+        return;
+    }
+
     if (timer == rexmitTimer)
         processRexmitTimer(event);
     else if (timer == persistTimer)
@@ -214,7 +222,8 @@ void TcpBaseAlg::processRexmitTimer(TcpEventCode& event)
     if (state->rexmit_timeout > MAX_REXMIT_TIMEOUT)
         state->rexmit_timeout = MAX_REXMIT_TIMEOUT;
 
-    conn->scheduleAfter(state->rexmit_timeout, rexmitTimer);
+    rexmitDeadline = simTime() + state->rexmit_timeout;
+    conn->scheduleAt(rexmitDeadline, rexmitTimer);
 
     EV_INFO << " to " << state->rexmit_timeout << "s, and cancelling RTT measurement\n";
 
@@ -312,7 +321,12 @@ void TcpBaseAlg::startRexmitTimer()
     state->rexmit_count = 0;
 
     // schedule timer
-    conn->scheduleAfter(state->rexmit_timeout, rexmitTimer);
+    rexmitDeadline = simTime() + state->rexmit_timeout;
+    if (lazyRexmitTimer && rexmitTimer->isScheduled() && rexmitTimer->getArrivalTime() <= rexmitDeadline)
+        return; // leave the timer in the FES, processTimer() moves it to the deadline when it expires
+    if (rexmitTimer->isScheduled())
+        cancelEvent(rexmitTimer);
+    conn->scheduleAt(rexmitDeadline, rexmitTimer);
 }
 
 void TcpBaseAlg::rttMeasurementComplete(simtime_t tSent, simtime_t tAcked)
@@ -486,7 +500,6 @@ void TcpBaseAlg::receivedDataAck(uint32_t firstSeqAcked)
         EV_INFO << "ACK acks some but not all outstanding segments ("
                 << (state->snd_max - state->snd_una) << " bytes outstanding), "
                 << "restarting REXMIT timer\n";
-        cancelEvent(rexmitTimer);
         startRexmitTimer();
     }
 
@@ -600,9 +613,6 @@ void TcpBaseAlg::segmentRetransmitted(uint32_t fromseq, uint32_t toseq)
 
 void TcpBaseAlg::restartRexmitTimer()
 {
-    if (rexmitTimer->isScheduled())
-        cancelEvent(rexmitTimer);
-
     startRexmitTimer();
 }
 
@@ -48,6 +48,9 @@ class INET_API TcpBaseAlg : public TcpAlgorithm
     cMessage *delayedAckTimer;
     cMessage *keepAliveTimer;
 
+    bool lazyRexmitTimer = false;
+    simtime_t rexmitDeadline; // the REXMIT timer may be scheduled earlier than this if lazyRexmitTimer is set
+
     static simsignal_t cwndSignal; // will record changes to snd_cwnd
     static simsignal_t ssthreshSignal; // will record changes to ssthresh
     static simsignal_t rttSignal; // will record measured RTT
@@ -319,6 +319,7 @@ void Udp::bind(int sockId, const L3Address& localAddr, int localPort)
             sd->localPort = localPort;
             socketsByPortMap[sd->localPort].push_back(sd);
         }
+        invalidateSocketLookupCache();
     }
     else {
         sd = createSocket(sockId, localAddr, localPort);
@@ -356,6 +357,7 @@ Udp::SockDesc *Udp::createSocket(int sockId, const L3Address& localAddr, int loc
     // add to socketsByPortMap
     SockDescList& list = socketsByPortMap[sd->localPort]; // create if doesn't exist
     list.push_back(sd);
+    invalidateSocketLookupCache();
 
     EV_INFO << "Socket created: " << *sd << "\n";
     return sd;
@@ -391,6 +393,7 @@ void Udp::connect(int sockId, const L3Address& remoteAddr, int remotePort)
     sd->remoteAddr = remoteAddr;
     sd->remotePort = remotePort;
     sd->onlyLocalPortIsSet = false;
+    invalidateSocketLookupCache();
 
     EV_INFO << "Socket connected: " << *sd << "\n";
 }
@@ -897,6 +900,7 @@ void Udp::destroySocket(SocketsByIdMap::iterator it)
 
     if (list.empty())
         socketsByPortMap.erase(sd->localPort);
+    invalidateSocketLookupCache();
 
     delete sd;
 }
@@ -1021,6 +1025,20 @@ bool Udp::verifyCrc(const Protocol *networkProtocol, const Ptr<const UdpHeader>&
 }
 
 Udp::SockDesc *Udp::findSocketForUnicastPacket(const L3Address& localAddr, ushort localPort, const L3Address& remoteAddr, ushort remotePort)
+{
+    // the datagrams of a flow carry the same addresses and ports, so the walk over the sockets is done once per flow
+    UnicastLookupKey key = { localAddr, remoteAddr, localPort, remotePort };
+    auto cacheIt = unicastLookupCache.find(key);
+    if (cacheIt != unicastLookupCache.end())
+        return cacheIt->second;
+    if (unicastLookupCache.size() >= MAX_UNICAST_LOOKUP_CACHE_SIZE)
+        invalidateSocketLookupCache();
+    SockDesc *sd = matchSocketForUnicastPacket(localAddr, localPort, remoteAddr, remotePort);
+    unicastLookupCache[key] = sd;
+    return sd;
+}
+
+Udp::SockDesc *Udp::matchSocketForUnicastPacket(const L3Address& localAddr, ushort localPort, const L3Address& remoteAddr, ushort remotePort)
 {
     auto it = socketsByPortMap.find(localPort);
     if (it == socketsByPortMap.end())
@@ -1329,6 +1347,7 @@ void Udp::clearAllSockets()
 
     socketsByIdMap.clear();
     socketsByPortMap.clear();
+    invalidateSocketLookupCache();
 }
 
 // #############################
@@ -10,6 +10,7 @@
 
 #include <list>
 #include <map>
+#include <unordered_map>
 
 #include "inet/common/Protocol.h"
 #include "inet/common/lifecycle/ModuleOperations.h"
@@ -105,12 +106,34 @@ class INET_API Udp : public TransportProtocolBase
     typedef std::map<int, SockDesc *> SocketsByIdMap;
     typedef std::map<int, SockDescList> SocketsByPortMap;
 
+    struct UnicastLookupKey {
+        L3Address localAddr;
+        L3Address remoteAddr;
+        ushort localPort;
+        ushort remotePort;
+
+        bool operator==(const UnicastLookupKey& other) const {
+            return localPort == other.localPort && remotePort == other.remotePort && localAddr == other.localAddr && remoteAddr == other.remoteAddr;
+        }
+    };
+
+    struct UnicastLookupKeyHash {
+        size_t operator()(const UnicastLookupKey& key) const {
+            return key.localAddr.getHash() * 31 + key.remoteAddr.getHash() + ((size_t)key.localPort << 16 | key.remotePort);
+        }
+    };
+
+    typedef std::unordered_map<UnicastLookupKey, SockDesc *, UnicastLookupKeyHash> UnicastLookupCache;
+
+    static const size_t MAX_UNICAST_LOOKUP_CACHE_SIZE = 65536;
+
   protected:
     CrcMode crcMode = CRC_MODE_UNDEFINED;
 
     // sockets
     SocketsByIdMap socketsByIdMap;
     SocketsByPortMap socketsByPortMap;
+    UnicastLookupCache unicastLookupCache; // results of findSocketForUnicastPacket() including nullptr, cleared when the sockets change
 
     // other state vars
     ushort lastEphemeralPort = EPHEMERAL_PORTRANGE_START;
@@ -163,6 +186,8 @@ class INET_API Udp : public TransportProtocolBase
     virtual ushort getEphemeralPort();
 
     virtual SockDesc *findSocketForUnicastPacket(const L3Address& localAddr, ushort localPort, const L3Address& remoteAddr, ushort remotePort);
+    SockDesc *matchSocketForUnicastPacket(const L3Address& localAddr, ushort localPort, const L3Address& remoteAddr, ushort remotePort);
+    void invalidateSocketLookupCache() { unicastLookupCache.clear(); }
     virtual std::vector<SockDesc *> findSocketsForMcastBcastPacket(const L3Address& localAddr, ushort localPort, const L3Address& remoteAddr, ushort remotePort, bool isMulticast, bool isBroadcast);
     virtual SockDesc *findFirstSocketByLocalAddress(const L3Address& localAddr, ushort localPort);
     virtual void sendUp(Ptr<const UdpHeader>& header, Packet *payload, SockDesc *sd, ushort srcPort, ushort destPort);